@@ -64,14 +64,93 @@
 /* frecuencia de reloj requerida (ticks/segundo) */
 #define TICK 100
 
-/* constante usada en implementacion de round robin */
-#define TICKS_POR_RODAJA 10
+/* constantes usadas en implementacion de prioridades */
+#define NUM_PRIO 32 /* niveles de prioridad (uno por bit del mapa de listos) */
+#define PRIO_MAX 0 /* nivel mas prioritario */
+#define PRIO_MIN (NUM_PRIO-1) /* nivel menos prioritario */
+#define PRIO_DEFECTO 16 /* prioridad inicial de los procesos */
+
+/* constantes usadas en implementacion de round robin. La rodaja es la
+   latencia objetivo repartida entre los procesos listos, sin bajar de
+   la granularidad minima; ambas se pueden cambiar con fijar_parametro */
+#define TICKS_POR_RODAJA 10 /* rodaja de referencia */
+#define LATENCIA_OBJETIVO 40 /* ticks en que deben ejecutar todos los listos */
+#define GRANULARIDAD_MIN 2 /* rodaja minima */
+
+/* parametros del nucleo modificables con fijar_parametro */
+#define PARAM_LATENCIA 0
+#define PARAM_GRANULARIDAD 1
+#define PARAM_UTILIZACION_RT 2
+#define PARAM_CEDER_PROPIETARIO 3
+#define PARAM_MAX_DESCRIPTORES 4
+#define PARAM_MAX_MUTEX 5
+#define NUM_PARAMETROS 6
+
+/* politica de planificacion si no se elige otra en el arranque
+   (fifo, rr, mlfq, cfs o stride) */
+#define PLANIFICADOR_DEFECTO "rr"
+
+/* constantes usadas en implementacion de MLFQ */
+#define NIVELES_MLFQ 4 /* niveles que puede descender un proceso */
+#define TICKS_ENVEJECIMIENTO 100 /* periodo con que todos vuelven arriba */
+
+/* constantes usadas en implementacion de CFS */
+#define CFS_PESO_DEFECTO 1024 /* peso de un proceso con PRIO_DEFECTO */
+#define CFS_ESCALA 1024 /* vruntime que suma un tick con el peso por defecto */
+#define CFS_GRANULARIDAD 2 /* ticks de ventaja necesarios para expulsar */
+#define CFS_UMBRAL_DESPERTAR TICKS_POR_RODAJA /* credito maximo al despertar */
+
+/* constantes usadas en implementacion de stride */
+#define TICKETS_DEFECTO 100 /* tickets iniciales de los procesos */
+#define TICKETS_MAX 10000 /* maximo de tickets propios de un proceso */
+#define STRIDE_ESCALA (1<<20) /* pase que suma un tick con un solo ticket */
+
+/* constante usada en implementacion de la clase de tiempo real (EDF) */
+#define UTILIZACION_MAX_RT 90 /* % de UCP reservable por defecto */
+
+/* constantes usadas en implementacion de grupos de procesos */
+#define NUM_GRUPOS MAX_PROC /* como mucho un grupo por proceso */
+#define GRUPO_INICIAL 0 /* grupo de init, que nunca se libera */
+#define GRUPO_PESO_DEFECTO 1024 /* peso de un grupo en cfs y stride */
+#define GRUPO_PESO_MAX 65536
+
+/* constantes usadas en implementacion de la rueda de temporizacion */
+#define BITS_RUEDA 6 /* cada nivel tiene 2^BITS_RUEDA cubetas */
+#define CUBETAS_RUEDA (1<<BITS_RUEDA)
+#define NIVELES_RUEDA 4 /* alcance de 2^(BITS_RUEDA*NIVELES_RUEDA) ticks */
 
 /* constantes usada en implementacion de mutex */
-#define NUM_MUT 16 /* numero total de mutex en el sistema */
+#define NUM_MUT 16 /* numero total de mutex en el sistema (por defecto) */
+#define MAX_MUT 4096 /* limite para PARAM_MAX_MUTEX */
+#define MUTEX_POR_SLAB 16 /* mutex que se reservan de una vez */
 #define NUM_MUT_PROC 4 /* numero maximo de mutex que puede tener abiertos un proceso */
+#define MAX_DESC_PROC 1024 /* limite para PARAM_MAX_DESCRIPTORES */
 #define MAX_NOM_MUT 8 /* longitud maxima de un nombre de mutex */
 
+/* constante usada en implementacion de semaforos */
+#define NUM_SEM 16 /* numero total de semaforos en el sistema */
+
+/* constante usada en implementacion de variables condicion */
+#define NUM_COND 16 /* numero total de variables condicion en el sistema */
+
+/* constante usada en implementacion de cerrojos de lectores/escritores */
+#define NUM_RW 16 /* numero total de cerrojos de lectura/escritura */
+
+/* constante usada en implementacion de barreras */
+#define NUM_BARRERAS 16 /* numero total de barreras en el sistema */
+
+/* constantes usadas en implementacion de colas de mensajes */
+#define NUM_COLAS 16 /* numero total de colas de mensajes en el sistema */
+#define MAX_CAPACIDAD_COLA 256 /* mensajes que puede guardar una cola */
+#define MAX_TAM_MENSAJE (1<<20) /* bytes de datos de un mensaje */
+#define NO_BLOQUEANTE 1 /* modo de enviar y recibir que no espera */
+
+/* constante usada en implementacion del espacio de nombres de objetos */
+#define TAM_TABLA_NOMBRES 256 /* cubetas de la tabla hash (potencia de 2) */
+
+/* constante usada en implementacion de futex */
+#define TAM_TABLA_FUTEX 64 /* colas de espera por direccion */
+
 /* constante usada en implementacion de manejador de terminal */
 #define TAM_BUF_TERM 8 /* tama�o del buffer del terminal */
 
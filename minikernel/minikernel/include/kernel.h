@@ -26,6 +26,22 @@
 #include "llamsis.h"
 #include <string.h>
 
+/*
+ *
+ * Definicion del tipo que corresponde con un descriptor de la tabla de
+ * cada proceso: la clase del objeto del nucleo (OBJ_*) y un puntero a el.
+ * Los libres se encadenan en una lista y los abiertos en otra, doblemente
+ * enlazada, para cerrarlos al terminar sin recorrer la tabla entera.
+ *
+ */
+typedef struct {
+	int tipo;	/* clase del objeto, 0 si esta libre */
+	void *objeto;
+	int uso;	/* modo en que se tiene cogido (RW_*) */
+	int sig;	/* siguiente libre o siguiente abierto (-1 si no hay) */
+	int ant;	/* anterior abierto */
+} descriptor;
+
 /*
  *
  * Definicion del tipo que corresponde con el BCP.
@@ -39,11 +55,47 @@ typedef struct BCP_t {
         int estado;			/* TERMINADO|LISTO|EJECUCION|BLOQUEADO*/
         contexto_t contexto_regs;	/* copia de regs. de UCP */
         void * pila;			/* dir. inicial de la pila */
-				int t_dormir; // Guarda el tiempo que se duerme
+				unsigned long long t_despertar; /* tick absoluto en que despierta */
+				BCPptr t_sig;	/* enlaces en la cubeta de la rueda */
+				BCPptr t_ant;
+				struct BCP_t **t_cubeta; /* cubeta en la que esta */
+				struct lista_BCPs_t *t_lista; /* cola de la que sale si vence el plazo */
 				int n_descriptores; //3Numero de descriptores
-				int descriptores[NUM_MUT_PROC]; //3) AÑADIDA. Array de descriptores
+				descriptor *descriptores; /* tabla que crece segun hace falta */
+				int tam_descriptores; /* entradas que tiene la tabla */
+				int desc_libre; /* primer descriptor libre o -1 */
+				int desc_abiertos; /* primer descriptor abierto o -1 */
+				int prioridad; /* prioridad efectiva (0 la maxima): la base o la heredada */
+				int prio_base; /* prioridad fijada con fijar_prioridad */
+				struct mutex_t *mutex_esperado; /* mutex en cuya cola espera o NULL */
+				int nivel; /* nivel de la cola de listos en que se encola */
+				int nivel_mlfq; /* niveles descendidos por agotar rodajas */
+				unsigned long long vruntime; /* tiempo virtual de CFS (pase en stride) */
+				int tickets; /* tickets propios (stride) */
+				int tickets_recibidos; /* prestados por procesos que esperan un mutex suyo */
+				int tickets_prestados; /* los que tiene prestados a otro proceso */
+				BCPptr receptor; /* proceso al que se los ha prestado */
+				int grupo; /* grupo de procesos al que pertenece */
+				int *futex_dir; /* palabra en la que espera (futex_wait) */
+				struct mensaje_t *mensajes; /* buffers de mensaje que son suyos */
+				struct mensaje_t *msj_pendiente; /* el que entrega o recibe bloqueado */
+				int tiempo_real; /* !=0 si pertenece a la clase EDF */
+				unsigned int rt_periodo; /* parametros de EDF, en ticks */
+				unsigned int rt_presupuesto;
+				unsigned int rt_plazo;
+				int rt_densidad; /* presupuesto/plazo, en milesimas */
+				int rt_restante; /* presupuesto que queda en el periodo */
+				unsigned long long rt_activacion; /* inicio del periodo actual */
+				unsigned long long rt_vencimiento; /* plazo absoluto */
+				BCPptr rb_padre;	/* enlaces en el arbol de listos de CFS */
+				BCPptr rb_izq;
+				BCPptr rb_der;
+				int rb_color;
+				int peso_listo;	/* peso contado en su grupo (0 si no esta en listos) */
+				BCPptr grupo_sig; /* enlaces en los listos de su grupo */
+				BCPptr grupo_ant;
 		//4) Variables round robin
-				unsigned int slice; /*Tiempo de ejecucion que le queda al proceso(Rodaja) !!!!!!!!*/
+				int slice; /*Tiempo de ejecucion que le queda al proceso(Rodaja) !!!!!!!!*/
 				BCPptr siguiente;		/* puntero a otro BCP */
 				void *info_mem;			/* descriptor del mapa de memoria */
 
@@ -57,7 +109,7 @@ typedef struct BCP_t {
  *
  */
 
-typedef struct{
+typedef struct lista_BCPs_t{
 	BCP *primero;
 	BCP *ultimo;
 } lista_BCPs;
@@ -75,13 +127,176 @@ BCP * p_proc_actual=NULL;
 
 BCP tabla_procs[MAX_PROC];
 
+/*
+ *
+ * Definicion del tipo que corresponde con la cola de procesos listos.
+ * Tiene una lista de BCPs por nivel de prioridad y un mapa de bits en
+ * el que el bit i esta activo si el nivel i tiene algun proceso, lo que
+ * permite encontrar el nivel mas prioritario no vacio en tiempo constante.
+ *
+ */
+typedef struct{
+	unsigned int mapa;
+	lista_BCPs niveles[NUM_PRIO];
+} cola_prio;
+
 /*
  * Variable global que representa la cola de procesos listos
  */
-lista_BCPs lista_listos= {NULL, NULL};
+cola_prio cola_listos;
+
+
+
+
+/*
+ *
+ * Definicion del tipo que corresponde con un arbol rojo-negro de BCPs
+ * ordenado por vruntime, usado como conjunto de listos por CFS. Se guarda
+ * el nodo mas a la izquierda para elegir el siguiente proceso en O(1);
+ * insertar y eliminar son O(log n).
+ *
+ */
+#define ROJO 0
+#define NEGRO 1
+
+typedef struct{
+	BCP *raiz;
+	BCP *minimo;
+} arbol_BCPs;
+
+/*
+ * Variable global que representa el arbol de procesos listos de CFS
+ */
+arbol_BCPs arbol_listos= {NULL, NULL};
+
+/*
+ * Variable global con el menor vruntime visto por CFS o stride (nunca
+ * decrece). Sirve de referencia para procesos nuevos y para los que
+ * despiertan.
+ */
+unsigned long long min_vruntime=0;
+
+/*
+ * Variable global con el peso de CFS de cada prioridad. Cada nivel pesa
+ * un 25% mas que el siguiente, y PRIO_DEFECTO pesa CFS_PESO_DEFECTO.
+ */
+int peso_prioridad[NUM_PRIO]={
+	36291, 29154, 23254, 18705, 14949, 11916, 9548, 7620,
+	6100, 4904, 3906, 3121, 2501, 1991, 1586, 1277,
+	1024, 820, 655, 526, 423, 335, 272, 215,
+	172, 137, 110, 87, 70, 56, 45, 36
+};
+
+/*
+ *
+ * Definicion del tipo que corresponde con una politica de planificacion.
+ * Todo acceso a los procesos listos pasa por estas operaciones, de modo
+ * que se pueden agregar politicas sin tocar el resto del nucleo. Se
+ * invocan con la interrupcion de reloj inhibida.
+ *
+ */
+typedef struct{
+	char *nombre;
+	void (*nuevo)(BCP *proc);	/* inicia un proceso recien creado */
+	void (*encolar)(BCP *proc);	/* inserta un proceso en listos */
+	void (*desencolar)(BCP *proc);	/* saca un proceso de listos */
+	BCP * (*elegir)();		/* siguiente a ejecutar (sin sacarlo) */
+	int (*rodaja)(BCP *proc);	/* rodaja al pasar a ejecucion */
+	int (*tick)(BCP *proc);		/* carga un tick; !=0 si debe dejar UCP */
+	void (*despertar)(BCP *proc);	/* ajustes al desbloquearse */
+	void (*ceder)(BCP *proc);	/* vuelta a listos del expulsado */
+	int (*expulsa)(BCP *proc, BCP *actual); /* !=0 si proc expulsa a actual */
+	int (*peso)(BCP *proc);		/* peso en el reparto entre grupos */
+} clase_planif;
+
+/*
+ * Variable global que indica la politica de planificacion en uso
+ */
+clase_planif *politica=NULL;
+
+/*
+ * Variable global con los procesos listos de la clase de tiempo real,
+ * ordenada por plazo absoluto. Tiene preferencia sobre la politica.
+ */
+lista_BCPs lista_tiempo_real= {NULL, NULL};
+
+/*
+ * Variables globales con la densidad (presupuesto/plazo, en milesimas)
+ * reservada por la clase de tiempo real y el porcentaje maximo admitido
+ */
+int densidad_rt=0;
+int utilizacion_max_rt=UTILIZACION_MAX_RT;
+
+/*
+ *
+ * Definicion del tipo que corresponde con un grupo de procesos. Un hijo
+ * hereda el grupo de su padre. El peso reparte la UCP entre grupos con
+ * cfs y stride (dentro del grupo se reparte entre sus procesos), y el
+ * limite, con cualquier politica, acota los ticks por segundo que puede
+ * consumir el grupo: al alcanzarlo sus procesos quedan retenidos hasta
+ * el siguiente segundo. No afecta a los procesos de tiempo real.
+ *
+ */
+typedef struct{
+	int en_uso;
+	int n_procs;		/* procesos del grupo */
+	int peso;
+	int limite;		/* ticks por segundo (0 sin limite) */
+	int consumidos;		/* ticks consumidos en el segundo actual */
+	int retenido;		/* !=0 si ha alcanzado el limite */
+	lista_BCPs retenidos;	/* procesos que esperan al siguiente segundo */
+	BCP *listos;		/* sus procesos en la cola de listos */
+	int n_listos;
+	unsigned long long peso_listos; /* suma de los pesos de sus listos */
+} grupo;
+
+/*
+ * Variable global que representa la tabla de grupos de procesos
+ */
+grupo tabla_grupos[NUM_GRUPOS];
 
+/*
+ * Variables globales con la suma de los pesos de los procesos listos de
+ * la politica y la de los pesos de los grupos que tienen alguno. Se
+ * mantienen al insertar y eliminar de listos para no tener que recorrer
+ * la tabla de procesos en cada tick.
+ */
+unsigned long long peso_total_listos=0;
+unsigned long long peso_grupos_listos=0;
 
+/*
+ * Variables globales con la latencia objetivo y la granularidad minima
+ * con que se calcula la rodaja, y el numero de procesos listos de la
+ * politica en uso (sin contar al que esta en ejecucion)
+ */
+int latencia_objetivo=LATENCIA_OBJETIVO;
+int granularidad_min=GRANULARIDAD_MIN;
+int n_listos=0;
 
+/*
+ * Variable global que indica si lock, en vez de bloquearse, cede la UCP
+ * al propietario del mutex cuando este esta listo
+ */
+int ceder_al_propietario=0;
+
+/*
+ * Variable global con el numero maximo de descriptores que puede tener
+ * abiertos un proceso. Por defecto el de la practica (NUM_MUT_PROC)
+ */
+int max_descriptores=NUM_MUT_PROC;
+
+/*
+ * Variable global que cuenta los ticks que faltan para el siguiente
+ * envejecimiento de MLFQ
+ */
+int ticks_envejecer=TICKS_ENVEJECIMIENTO;
+
+/*
+ * Variable global que indica que hay que expulsar al proceso actual.
+ * La activa int_reloj (o quien despierte a un proceso mas prioritario)
+ * y la atiende int_sw, donde se realiza el cambio de contexto.
+ */
+int replanificar=0;
 
 /*
  *
@@ -102,36 +317,339 @@ int sis_crear_proceso();
 int sis_terminar_proceso();
 int sis_escribir();
 int obtener_id_pr();
+int sis_fijar_prioridad();
+int sis_fijar_tickets();
+int sis_fijar_tiempo_real();
+int sis_fijar_parametro();
+int sis_ceder();
+int sis_ceder_a();
+int sis_crear_grupo();
+int sis_fijar_grupo();
 
 //Dormir
 int dormir(unsigned int segundos);//llamada de dormir
+int sis_dormir_ms();
+int sis_dormir_hasta();
+int sis_obtener_ticks();
 
-lista_BCPs lista_dormidos = {NULL, NULL};
+/*
+ *
+ * Definicion del tipo que corresponde con una rueda de temporizacion
+ * jerarquica. El nivel 0 tiene una cubeta por tick; cada cubeta del nivel
+ * n abarca CUBETAS_RUEDA cubetas del nivel n-1 y se reparte en ellas
+ * cuando le llega el turno. Insertar y cancelar son O(1) y un tick sin
+ * vencimientos solo mira una cubeta vacia.
+ *
+ */
+typedef struct{
+	BCP *cubetas[NIVELES_RUEDA][CUBETAS_RUEDA];
+	unsigned long long ticks; /* siguiente tick por procesar */
+} rueda_temp;
+
+/*
+ * Variable global con la rueda de procesos dormidos
+ */
+rueda_temp rueda_dormidos;
+
+/*
+ * Variable global con los ticks transcurridos desde el arranque
+ */
+unsigned long long ticks_sistema=0;
+
+/*
+ *
+ * Definicion del tipo que corresponde con una entrada del espacio de
+ * nombres de objetos del nucleo (mutex y demas objetos con nombre). Va
+ * dentro del propio objeto y guarda una copia del nombre en memoria del
+ * nucleo, de modo que no depende de la imagen del proceso que lo creo.
+ * Las entradas se encadenan en una tabla hash indexada por el nombre.
+ *
+ */
+#define OBJ_MUTEX 1
+#define OBJ_SEM 2
+#define OBJ_COND 3
+#define OBJ_RW 4
+#define OBJ_BARRERA 5
+#define OBJ_COLA 6
+
+typedef struct nombre_t {
+	char texto[MAX_NOM_MUT+1];
+	unsigned int hash;
+	int tipo;		/* clase del objeto (OBJ_*) */
+	void *objeto;		/* objeto al que pertenece */
+	struct nombre_t *sig;	/* siguiente en la cubeta */
+} nombre_obj;
+
+/*
+ * Variable global que representa la tabla hash del espacio de nombres
+ */
+nombre_obj *tabla_nombres[TAM_TABLA_NOMBRES];
+
+/*
+ * Variable global con las colas de procesos bloqueados en futex_wait.
+ * Cada cola agrupa las direcciones que caen en la misma entrada.
+ */
+lista_BCPs colas_futex[TAM_TABLA_FUTEX];
+
+int sis_futex_wait();
+int sis_futex_wake();
 
 //MUTEX
 int crear_mutex (char *nombre, int tipo);
 int abrir_mutex(char *nombre);
 int cerrar_mutex (unsigned int mutexid);
+int cerrar_descriptor (unsigned int mutexid); //cierre interno, tambien al terminar
 int lock (unsigned int mutexid);
 int unlock (unsigned int mutexid);
+int trylock ();
+int lock_timeout ();
+int estadisticas_mutex ();
 
-//Struct para el mutex
+//Plazo de una espera por un mutex que no vence nunca
+#define SIN_PLAZO (~0ULL)
+
+/*
+ * Estadisticas de uso de un mutex, en ticks. La llamada
+ * estadisticas_mutex las copia tal cual a una estructura de usuario con
+ * la misma forma (ver servicios.h).
+ */
 typedef struct {
-	char *nombre;
+	char nombre[MAX_NOM_MUT+1];
+	unsigned int adquisiciones;	/* veces que se ha cogido */
+	unsigned int con_espera;	/* de ellas, las que tuvieron que esperar */
+	unsigned int espera_total;
+	unsigned int espera_max;
+	unsigned int retencion_total;	/* tiempo cogido hasta soltarlo */
+	unsigned int retencion_max;
+	unsigned int cola_max;		/* procesos esperando a la vez */
+} estad_mutex;
+
+//Struct para el mutex
+typedef struct mutex_t {
+	nombre_obj nombre; /* nombre registrado en el espacio de nombres */
+	struct mutex_t *sig_libre; /* siguiente mutex libre si no esta en uso */
 	int tipo; //Recursivo o no recursivo
 	int propietario; //Id del proceso
 	int abierto; 
 	int locked;
 	//Lista de cada mutex
 	lista_BCPs lista_proc_esperando_lock;
+	unsigned long long t_cogido; /* tick en que lo cogio el propietario */
+	estad_mutex estad;
 } mutex;
-//Array para guardar mutex utilizados. Tamaño = numero maximo de mutex
-mutex array_mutex[NUM_MUT];
+/*
+ * Los mutex se reservan por bloques (slabs) de MUTEX_POR_SLAB a medida
+ * que hacen falta y no se mueven ni se devuelven, de modo que los
+ * descriptores y las colas pueden apuntar a ellos. La posicion de un
+ * mutex (para estadisticas_mutex) es la de su slab por MUTEX_POR_SLAB
+ * mas la que ocupa dentro de el.
+ */
+typedef struct {
+	mutex objetos[MUTEX_POR_SLAB];
+} slab_mutex;
+//Slabs reservados, en orden de creacion
+slab_mutex *slabs_mutex[MAX_MUT/MUTEX_POR_SLAB];
+int n_slabs_mutex=0;
 //Variable que almacena el numero de mutex creados
 int mutex_creados;
+//Numero maximo de mutex en el sistema. Por defecto el de la practica
+int max_mutex=NUM_MUT;
+//Primer mutex libre de los slabs (NULL si no hay)
+mutex *mutex_libre=NULL;
 //Lista de procesos bloqueados porque se habian creado el numero maximo de mutex permitidos
 lista_BCPs lista_bloq_mutex = {NULL, NULL};
 
+/*
+ *
+ * Definicion del tipo que corresponde con un semaforo contador. Usa los
+ * mismos descriptores por proceso que los mutex.
+ *
+ */
+typedef struct {
+	nombre_obj nombre;	/* nombre registrado en el espacio de nombres */
+	int sig_libre;		/* siguiente semaforo libre si no esta en uso */
+	int contador;
+	int abierto;		/* descriptores que lo tienen abierto */
+	lista_BCPs esperando;	/* procesos bloqueados en wait_sem (FIFO) */
+} semaforo;
+
+/*
+ * Variables globales con la tabla de semaforos y el primero libre
+ */
+semaforo array_sem[NUM_SEM];
+int sem_libre;
+
+int crear_sem();
+int abrir_sem();
+int wait_sem();
+int post_sem();
+int cerrar_sem();
+int cerrar_sem_desc (unsigned int desc); //cierre interno, tambien al terminar
+
+/*
+ *
+ * Definicion del tipo que corresponde con una variable condicion. Se usa
+ * siempre junto a un mutex, que cond_wait suelta mientras espera.
+ *
+ */
+typedef struct {
+	nombre_obj nombre;	/* nombre registrado en el espacio de nombres */
+	int sig_libre;		/* siguiente variable libre si no esta en uso */
+	int abierto;		/* descriptores que la tienen abierta */
+	lista_BCPs esperando;	/* procesos bloqueados en cond_wait (FIFO) */
+} condicion;
+
+/*
+ * Variables globales con la tabla de variables condicion y la primera libre
+ */
+condicion array_cond[NUM_COND];
+int cond_libre;
+
+int crear_cond();
+int abrir_cond();
+int cond_wait();
+int cond_signal();
+int cond_broadcast();
+int cerrar_cond();
+int cerrar_cond_desc (unsigned int desc); //cierre interno, tambien al terminar
+
+/*
+ *
+ * Definicion del tipo que corresponde con un cerrojo de lectores y
+ * escritores con preferencia para los escritores. El modo en que lo tiene
+ * cada proceso se guarda en el campo uso de su descriptor.
+ *
+ */
+#define RW_LIBRE 0
+#define RW_LECTOR 1
+#define RW_ESCRITOR 2
+
+typedef struct {
+	nombre_obj nombre;	/* nombre registrado en el espacio de nombres */
+	int sig_libre;		/* siguiente cerrojo libre si no esta en uso */
+	int abierto;		/* descriptores que lo tienen abierto */
+	int lectores;		/* lectores que lo tienen cogido */
+	int escritor;		/* escritor que lo tiene cogido o -1 */
+	lista_BCPs lectores_esperando;
+	lista_BCPs escritores_esperando;
+} cerrojo_rw;
+
+/*
+ * Variables globales con la tabla de cerrojos y el primero libre
+ */
+cerrojo_rw array_rw[NUM_RW];
+int rw_libre;
+
+int crear_rw();
+int abrir_rw();
+int lock_lectura();
+int lock_escritura();
+int unlock_rw();
+int cerrar_rw();
+int cerrar_rw_desc (unsigned int desc); //cierre interno, tambien al terminar
+
+/*
+ *
+ * Definicion del tipo que corresponde con una barrera para n procesos.
+ * Se puede reutilizar: al completarse vuelve a empezar la cuenta.
+ *
+ */
+typedef struct {
+	nombre_obj nombre;	/* nombre registrado en el espacio de nombres */
+	int sig_libre;		/* siguiente barrera libre si no esta en uso */
+	int abierto;		/* descriptores que la tienen abierta */
+	int n;			/* procesos que la completan */
+	int llegados;		/* procesos esperando en la vuelta actual */
+	lista_BCPs esperando;
+} barrera;
+
+/*
+ * Variables globales con la tabla de barreras y la primera libre
+ */
+barrera array_barreras[NUM_BARRERAS];
+int barrera_libre;
+
+int crear_barrera();
+int abrir_barrera();
+int esperar_barrera();
+int cerrar_barrera();
+int cerrar_barrera_desc (unsigned int desc); //cierre interno, tambien al terminar
+
+/*
+ *
+ * Definicion del tipo que corresponde con un mensaje. Los datos van en
+ * un buffer del nucleo que no se copia: lo pide un proceso con
+ * reservar_mensaje, enviar se lo pasa a la cola y recibir al receptor,
+ * que lo devuelve con liberar_mensaje. Mientras es de un proceso esta en
+ * su lista (para liberarlo si termina) y mientras esta en una cola, en la
+ * de la cola.
+ *
+ */
+typedef struct mensaje_t {
+	struct mensaje_t *sig;
+	struct mensaje_t *ant;	/* solo en la lista del proceso */
+	int propietario;	/* id del proceso o -1 si esta en una cola */
+	unsigned int longitud;
+	char datos[];		/* lo que ve el proceso */
+} mensaje;
+
+/*
+ *
+ * Definicion del tipo que corresponde con una cola de mensajes con nombre.
+ * Como mucho uno de sus dos grupos de procesos tiene alguno esperando:
+ * los receptores si esta vacia y los emisores si esta llena.
+ *
+ */
+typedef struct {
+	nombre_obj nombre;	/* nombre registrado en el espacio de nombres */
+	int sig_libre;		/* siguiente cola libre si no esta en uso */
+	int abierto;		/* descriptores que la tienen abierta */
+	int capacidad;		/* mensajes que caben */
+	int n_mensajes;
+	mensaje *primero;
+	mensaje *ultimo;
+	lista_BCPs receptores;	/* esperan a que llegue un mensaje */
+	lista_BCPs emisores;	/* esperan a que haya hueco */
+} cola_msj;
+
+/*
+ * Variables globales con la tabla de colas y la primera libre
+ */
+cola_msj array_colas[NUM_COLAS];
+int cola_libre;
+
+int crear_cola();
+int abrir_cola();
+int enviar();
+int recibir();
+int cerrar_cola();
+int cerrar_cola_desc (unsigned int desc); //cierre interno, tambien al terminar
+int reservar_mensaje();
+int liberar_mensaje();
+
+/*
+ *
+ * Definicion del tipo que corresponde con un parametro del nucleo
+ * modificable en tiempo de ejecucion, y tabla con todos ellos indexada
+ * por su numero (PARAM_*)
+ *
+ */
+typedef struct{
+	char *nombre;
+	int *valor;
+	int minimo;
+	int maximo;
+} parametro;
+
+parametro tabla_parametros[NUM_PARAMETROS]={
+					{"latencia", &latencia_objetivo, 1, 1000},
+					{"granularidad", &granularidad_min, 1, 1000},
+					{"utilizacion_rt", &utilizacion_max_rt, 1, 100},
+					{"ceder_propietario", &ceder_al_propietario, 0, 1},
+					{"max_descriptores", &max_descriptores, 1, MAX_DESC_PROC},
+					{"max_mutex", &max_mutex, 1, MAX_MUT}
+				};
+
 /*
  * Variable global que contiene las rutinas que realizan cada llamada
  */
@@ -145,7 +663,51 @@ servicio tabla_servicios[NSERVICIOS]={
 					{abrir_mutex},
 					{lock},
 					{unlock},
-					{cerrar_mutex}
+					{cerrar_mutex},
+					{sis_fijar_prioridad},
+					{sis_dormir_ms},
+					{sis_dormir_hasta},
+					{sis_obtener_ticks},
+					{sis_fijar_tickets},
+					{sis_fijar_tiempo_real},
+					{sis_fijar_parametro},
+					{sis_ceder},
+					{sis_ceder_a},
+					{sis_crear_grupo},
+					{sis_fijar_grupo},
+					{sis_futex_wait},
+					{sis_futex_wake},
+					{crear_sem},
+					{abrir_sem},
+					{wait_sem},
+					{post_sem},
+					{cerrar_sem},
+					{crear_cond},
+					{abrir_cond},
+					{cond_wait},
+					{cond_signal},
+					{cond_broadcast},
+					{cerrar_cond},
+					{crear_rw},
+					{abrir_rw},
+					{lock_lectura},
+					{lock_escritura},
+					{unlock_rw},
+					{cerrar_rw},
+					{crear_barrera},
+					{abrir_barrera},
+					{esperar_barrera},
+					{cerrar_barrera},
+					{trylock},
+					{lock_timeout},
+					{estadisticas_mutex},
+					{crear_cola},
+					{abrir_cola},
+					{enviar},
+					{recibir},
+					{cerrar_cola},
+					{reservar_mensaje},
+					{liberar_mensaje}
 				};
 
 #endif /* _KERNEL_H */
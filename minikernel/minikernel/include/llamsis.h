@@ -19,7 +19,7 @@
 #define _LLAMSIS_H
 
 /* Numero de llamadas disponibles */
-#define NSERVICIOS 10
+#define NSERVICIOS 54
 
 #define CREAR_PROCESO 0
 #define TERMINAR_PROCESO 1
@@ -35,5 +35,53 @@
 #define UNLOCK 8
 #define CERRAR_MUTEX 9
 
+//Numero de llamada para fijar la prioridad
+#define FIJAR_PRIORIDAD 10
+
+//Numeros de llamada para dormir con mas resolucion y leer el reloj
+#define DORMIR_MS 11
+#define DORMIR_HASTA 12
+#define OBTENER_TICKS 13
+#define FIJAR_TICKETS 14
+#define FIJAR_TIEMPO_REAL 15
+#define FIJAR_PARAMETRO 16
+#define CEDER 17
+#define CEDER_A 18
+#define CREAR_GRUPO 19
+#define FIJAR_GRUPO 20
+#define FUTEX_WAIT 21
+#define FUTEX_WAKE 22
+#define CREAR_SEM 23
+#define ABRIR_SEM 24
+#define WAIT_SEM 25
+#define POST_SEM 26
+#define CERRAR_SEM 27
+#define CREAR_COND 28
+#define ABRIR_COND 29
+#define COND_WAIT 30
+#define COND_SIGNAL 31
+#define COND_BROADCAST 32
+#define CERRAR_COND 33
+#define CREAR_RW 34
+#define ABRIR_RW 35
+#define LOCK_LECTURA 36
+#define LOCK_ESCRITURA 37
+#define UNLOCK_RW 38
+#define CERRAR_RW 39
+#define CREAR_BARRERA 40
+#define ABRIR_BARRERA 41
+#define ESPERAR_BARRERA 42
+#define CERRAR_BARRERA 43
+#define TRYLOCK 44
+#define LOCK_TIMEOUT 45
+#define ESTADISTICAS_MUTEX 46
+#define CREAR_COLA 47
+#define ABRIR_COLA 48
+#define ENVIAR 49
+#define RECIBIR 50
+#define CERRAR_COLA 51
+#define RESERVAR_MENSAJE 52
+#define LIBERAR_MENSAJE 53
+
 #endif /* _LLAMSIS_H */
 
@@ -15,6 +15,7 @@
 
 #include "kernel.h"	/* Contiene defs. usadas por este modulo */
 #include <string.h>
+#include <stdlib.h>
 
 /*
  *
@@ -33,6 +34,15 @@ static void iniciar_tabla_proc(){
 		tabla_procs[i].estado=NO_USADA;
 }
 
+/*
+ * Funcion que inicia la tabla de grupos con el grupo inicial
+ */
+static void iniciar_grupos(){
+	memset(tabla_grupos, 0, sizeof(tabla_grupos));
+	tabla_grupos[GRUPO_INICIAL].en_uso=1;
+	tabla_grupos[GRUPO_INICIAL].peso=GRUPO_PESO_DEFECTO;
+}
+
 /*
  * Funci�n que busca una entrada libre en la tabla de procesos
  */
@@ -48,7 +58,7 @@ static int buscar_BCP_libre(){
 /*
  *
  * Funciones que facilitan el manejo de las listas de BCPs
- *	insertar_ultimo eliminar_primero eliminar_elem
+ *	insertar_ultimo insertar_por_prioridad eliminar_primero eliminar_elem
  *
  * NOTA: PRIMERO SE DEBE LLAMAR A eliminar Y LUEGO A insertar
  */
@@ -65,6 +75,25 @@ static void insertar_ultimo(lista_BCPs *lista, BCP * proc){
 	proc->siguiente=NULL;
 }
 
+/*
+ * Inserta un BCP detras de los de su misma prioridad o mejor, de modo que
+ * la lista queda ordenada por prioridad y en orden de llegada dentro de
+ * cada prioridad.
+ */
+static void insertar_por_prioridad(lista_BCPs *lista, BCP * proc){
+	BCP *paux=lista->primero, *pant=NULL;
+
+	for ( ; ((paux) && (paux->prioridad<=proc->prioridad));
+		pant=paux, paux=paux->siguiente);
+	proc->siguiente=paux;
+	if (pant)
+		pant->siguiente=proc;
+	else
+		lista->primero=proc;
+	if (paux==NULL)
+		lista->ultimo=proc;
+}
+
 /*
  * Elimina el primer BCP de la lista.
  */
@@ -96,648 +125,3579 @@ static void eliminar_elem(lista_BCPs *lista, BCP * proc){
 
 /*
  *
- * Funciones relacionadas con la planificacion
- *	espera_int planificador
+ * Funciones que manejan el arbol rojo-negro de listos de CFS
+ *	rotar_izq rotar_der arbol_siguiente arbol_insertar arbol_eliminar
+ *
  */
 
+#define es_negro(n) (((n)==NULL) || ((n)->rb_color==NEGRO))
+
 /*
- * Espera a que se produzca una interrupcion
+ * Sustituye el subarbol con raiz en u por el subarbol con raiz en v.
  */
-static void espera_int(){
-	int nivel;
+static void trasplantar(arbol_BCPs *arbol, BCP * u, BCP * v){
+	if (u->rb_padre==NULL)
+		arbol->raiz=v;
+	else if (u==u->rb_padre->rb_izq)
+		u->rb_padre->rb_izq=v;
+	else
+		u->rb_padre->rb_der=v;
+	if (v)
+		v->rb_padre=u->rb_padre;
+}
 
-	printk("-> NO HAY LISTOS. ESPERA INT\n");
+static void rotar_izq(arbol_BCPs *arbol, BCP * x){
+	BCP *y=x->rb_der;
 
-	/* Baja al m�nimo el nivel de interrupci�n mientras espera */
-	nivel=fijar_nivel_int(NIVEL_1);
-	halt();
-	fijar_nivel_int(nivel);
+	x->rb_der=y->rb_izq;
+	if (y->rb_izq)
+		y->rb_izq->rb_padre=x;
+	trasplantar(arbol, x, y);
+	y->rb_izq=x;
+	x->rb_padre=y;
 }
 
-/*
- * Funci�n de planificacion que implementa un algoritmo FIFO.
- */
-static BCP * planificador(){
-	while (lista_listos.primero==NULL)
-		espera_int();		/* No hay nada que hacer */
-	return lista_listos.primero;
+static void rotar_der(arbol_BCPs *arbol, BCP * x){
+	BCP *y=x->rb_izq;
+
+	x->rb_izq=y->rb_der;
+	if (y->rb_der)
+		y->rb_der->rb_padre=x;
+	trasplantar(arbol, x, y);
+	y->rb_der=x;
+	x->rb_padre=y;
 }
 
 /*
- *
- * Funcion auxiliar que termina proceso actual liberando sus recursos.
- * Usada por llamada terminar_proceso y por rutinas que tratan excepciones
- *
+ * Devuelve el siguiente BCP en orden de vruntime (NULL si es el ultimo).
  */
-static void liberar_proceso(){
-	BCP * p_proc_anterior;
+static BCP * arbol_siguiente(BCP * proc){
+	BCP *padre;
 
-	liberar_imagen(p_proc_actual->info_mem); /* liberar mapa */
+	if (proc->rb_der) {
+		for (proc=proc->rb_der; proc->rb_izq; proc=proc->rb_izq);
+		return proc;
+	}
+	for (padre=proc->rb_padre; padre && (proc==padre->rb_der);
+		padre=padre->rb_padre)
+		proc=padre;
+	return padre;
+}
 
-	p_proc_actual->estado=TERMINADO;
-	eliminar_primero(&lista_listos); /* proc. fuera de listos */
+/*
+ * Inserta un BCP en el arbol. A igualdad de vruntime queda detras de los
+ * que ya estaban, lo que mantiene el orden de llegada.
+ */
+static void arbol_insertar(arbol_BCPs *arbol, BCP * proc){
+	BCP *padre=NULL, **enlace=&arbol->raiz, *abuelo, *tio;
+	int mas_izq=1;
+
+	while (*enlace) {
+		padre=*enlace;
+		if (proc->vruntime<padre->vruntime)
+			enlace=&padre->rb_izq;
+		else {
+			enlace=&padre->rb_der;
+			mas_izq=0;
+		}
+	}
+	*enlace=proc;
+	proc->rb_padre=padre;
+	proc->rb_izq=proc->rb_der=NULL;
+	proc->rb_color=ROJO;
+	if (mas_izq)
+		arbol->minimo=proc;
+
+	/* Restaura las propiedades del arbol rojo-negro */
+	while (((padre=proc->rb_padre)!=NULL) && (padre->rb_color==ROJO)) {
+		abuelo=padre->rb_padre;
+		if (padre==abuelo->rb_izq) {
+			tio=abuelo->rb_der;
+			if (!es_negro(tio)) {
+				padre->rb_color=tio->rb_color=NEGRO;
+				abuelo->rb_color=ROJO;
+				proc=abuelo;
+				continue;
+			}
+			if (proc==padre->rb_der) {
+				rotar_izq(arbol, padre);
+				proc=padre;
+				padre=proc->rb_padre;
+			}
+			padre->rb_color=NEGRO;
+			abuelo->rb_color=ROJO;
+			rotar_der(arbol, abuelo);
+		}
+		else {
+			tio=abuelo->rb_izq;
+			if (!es_negro(tio)) {
+				padre->rb_color=tio->rb_color=NEGRO;
+				abuelo->rb_color=ROJO;
+				proc=abuelo;
+				continue;
+			}
+			if (proc==padre->rb_izq) {
+				rotar_der(arbol, padre);
+				proc=padre;
+				padre=proc->rb_padre;
+			}
+			padre->rb_color=NEGRO;
+			abuelo->rb_color=ROJO;
+			rotar_izq(arbol, abuelo);
+		}
+	}
+	arbol->raiz->rb_color=NEGRO;
+}
 
-	/* Realizar cambio de contexto */
-	p_proc_anterior=p_proc_actual;
-	p_proc_actual=planificador();
+/*
+ * Elimina un BCP del arbol.
+ */
+static void arbol_eliminar(arbol_BCPs *arbol, BCP * proc){
+	BCP *y=proc, *x, *x_padre, *w;
+	int color=y->rb_color;
 
-	printk("-> C.CONTEXTO POR FIN: de %d a %d\n",
-			p_proc_anterior->id, p_proc_actual->id);
+	if (arbol->minimo==proc)
+		arbol->minimo=arbol_siguiente(proc);
 
-	liberar_pila(p_proc_anterior->pila);
-	cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
-        return; /* no deber�a llegar aqui */
+	if (proc->rb_izq==NULL) {
+		x=proc->rb_der;
+		x_padre=proc->rb_padre;
+		trasplantar(arbol, proc, x);
+	}
+	else if (proc->rb_der==NULL) {
+		x=proc->rb_izq;
+		x_padre=proc->rb_padre;
+		trasplantar(arbol, proc, x);
+	}
+	else {
+		for (y=proc->rb_der; y->rb_izq; y=y->rb_izq);
+		color=y->rb_color;
+		x=y->rb_der;
+		if (y->rb_padre==proc)
+			x_padre=y;
+		else {
+			x_padre=y->rb_padre;
+			trasplantar(arbol, y, x);
+			y->rb_der=proc->rb_der;
+			y->rb_der->rb_padre=y;
+		}
+		trasplantar(arbol, proc, y);
+		y->rb_izq=proc->rb_izq;
+		y->rb_izq->rb_padre=y;
+		y->rb_color=proc->rb_color;
+	}
+	if (color==ROJO)
+		return;
+
+	/* Se ha quitado un nodo negro: restaura las propiedades del arbol */
+	while ((x!=arbol->raiz) && es_negro(x)) {
+		if (x==x_padre->rb_izq) {
+			w=x_padre->rb_der;
+			if (w->rb_color==ROJO) {
+				w->rb_color=NEGRO;
+				x_padre->rb_color=ROJO;
+				rotar_izq(arbol, x_padre);
+				w=x_padre->rb_der;
+			}
+			if (es_negro(w->rb_izq) && es_negro(w->rb_der)) {
+				w->rb_color=ROJO;
+				x=x_padre;
+				x_padre=x->rb_padre;
+				continue;
+			}
+			if (es_negro(w->rb_der)) {
+				w->rb_izq->rb_color=NEGRO;
+				w->rb_color=ROJO;
+				rotar_der(arbol, w);
+				w=x_padre->rb_der;
+			}
+			w->rb_color=x_padre->rb_color;
+			x_padre->rb_color=NEGRO;
+			w->rb_der->rb_color=NEGRO;
+			rotar_izq(arbol, x_padre);
+		}
+		else {
+			w=x_padre->rb_izq;
+			if (w->rb_color==ROJO) {
+				w->rb_color=NEGRO;
+				x_padre->rb_color=ROJO;
+				rotar_der(arbol, x_padre);
+				w=x_padre->rb_izq;
+			}
+			if (es_negro(w->rb_izq) && es_negro(w->rb_der)) {
+				w->rb_color=ROJO;
+				x=x_padre;
+				x_padre=x->rb_padre;
+				continue;
+			}
+			if (es_negro(w->rb_izq)) {
+				w->rb_der->rb_color=NEGRO;
+				w->rb_color=ROJO;
+				rotar_izq(arbol, w);
+				w=x_padre->rb_izq;
+			}
+			w->rb_color=x_padre->rb_color;
+			x_padre->rb_color=NEGRO;
+			w->rb_izq->rb_color=NEGRO;
+			rotar_der(arbol, x_padre);
+		}
+		x=arbol->raiz;
+	}
+	if (x)
+		x->rb_color=NEGRO;
 }
 
 /*
  *
- * Funciones relacionadas con el tratamiento de interrupciones
- *	excepciones: exc_arit exc_mem
- *	interrupciones de reloj: int_reloj
- *	interrupciones del terminal: int_terminal
- *	llamadas al sistemas: llam_sis
- *	interrupciones SW: int_sw
+ * Politicas de planificacion. Cada una se describe con una clase_planif
+ * (ver kernel.h); el resto del nucleo solo accede a los procesos listos
+ * a traves de la politica en uso.
+ *	prio_*: cola por prioridades con mapa de bits (usada por fifo y rr)
+ *	mlfq_*: la misma cola, desplazando la prioridad segun el uso de UCP
+ *	cfs_*: arbol de listos ordenado por vruntime
+ *	stride_*: el mismo arbol, avanzando el vruntime segun los tickets
  *
  */
 
 /*
- * Tratamiento de excepciones aritmeticas
+ * Inserta un BCP al final del nivel indicado de la cola por prioridades.
  */
-static void exc_arit(){
-
-	if (!viene_de_modo_usuario())
-		panico("excepcion aritmetica cuando estaba dentro del kernel");
+static void prio_insertar(BCP * proc, int nivel){
+	proc->nivel=nivel;
+	insertar_ultimo(&cola_listos.niveles[nivel], proc);
+	cola_listos.mapa|=1U<<nivel;
+}
 
+static void prio_encolar(BCP * proc){
+	prio_insertar(proc, proc->prioridad);
+}
 
-	printk("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
-	liberar_proceso();
+/*
+ * Elimina un BCP de su nivel, desmarcando el nivel si queda vacio.
+ * Si el BCP es el primero de su nivel (caso habitual) el coste es O(1).
+ */
+static void prio_desencolar(BCP * proc){
+	lista_BCPs *nivel=&cola_listos.niveles[proc->nivel];
 
-        return; /* no deber�a llegar aqui */
+	eliminar_elem(nivel, proc);
+	if (nivel->primero==NULL)
+		cola_listos.mapa&=~(1U<<proc->nivel);
 }
 
 /*
- * Tratamiento de excepciones en el acceso a memoria
+ * Primer proceso del nivel mas prioritario no vacio. El nivel se obtiene
+ * del mapa de bits con una sola instruccion, sea cual sea el numero de
+ * procesos listos.
  */
-static void exc_mem(){
-
-	if (!viene_de_modo_usuario())
-		panico("excepcion de memoria cuando estaba dentro del kernel");
+static BCP * prio_elegir(){
+	if (cola_listos.mapa==0)
+		return NULL;
+	return cola_listos.niveles[__builtin_ctz(cola_listos.mapa)].primero;
+}
 
+/*
+ * Rodaja de un proceso que pasa a ejecucion: la latencia objetivo
+ * repartida entre los procesos listos y el propio proceso, con la
+ * granularidad minima como limite inferior. Con pocos procesos las
+ * rodajas son largas y con muchos todos ejecutan dentro de la latencia.
+ */
+static int prio_rodaja(BCP * proc){
+	int rodaja=latencia_objetivo/(n_listos+1);
 
-	printk("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
-	liberar_proceso();
+	return (rodaja<granularidad_min ? granularidad_min : rodaja);
+}
 
-        return; /* no deber�a llegar aqui */
+static int prio_expulsa(BCP * proc, BCP * actual){
+	return (proc->nivel<actual->prioridad);
 }
 
 /*
- * Tratamiento de interrupciones de terminal
+ * Operaciones comunes que no hacen nada o que se limitan a encolar.
  */
-static void int_terminal(){
-	char car;
+static void nada(BCP * proc){
+}
 
-	car = leer_puerto(DIR_TERMINAL);
-	printk("-> TRATANDO INT. DE TERMINAL %c\n", car);
+static int nunca(BCP * proc){
+	return 0;
+}
 
-        return;
+static int nunca_expulsa(BCP * proc, BCP * actual){
+	return 0;
 }
 
 /*
- * Tratamiento de interrupciones de reloj
+ * Round robin: agota la rodaja y vuelve al final de su nivel.
  */
-static void int_reloj(){
+static int rr_tick(BCP * proc){
+	return (--proc->slice<=0);
+}
 
-	printk("-> TRATANDO INT. DE RELOJ\n");
+/*
+ * MLFQ: la prioridad base se desplaza tantos niveles como haya descendido
+ * el proceso por agotar rodajas, y la rodaja se duplica en cada nivel
+ * descendido: los procesos intensivos en UCP esperan mas pero expulsan
+ * menos. Los que se bloquean antes de agotarla conservan su nivel.
+ */
+static int mlfq_nivel(BCP * proc){
+	int nivel=proc->prioridad+proc->nivel_mlfq;
 
+	return (nivel>PRIO_MIN ? PRIO_MIN : nivel);
+}
 
-	BCP* proceso = lista_dormidos.primero;
-		
-	while (proceso != NULL) {
-		//Disminuir su tiempo
-		proceso->t_dormir--;
-		printk("El proceso cuyo id es %d le quedan %d\n", proceso-> id, proceso->t_dormir);
-		//Si el plazo ha acabado, desbloquear
-		//Antes de borrarlo hay que guardar el siguiente proceso al que apunta en la cola dormidos
-		//Si se borra despues, apunta a otro que no esta dormido!!
-		BCP* proceso_siguiente = proceso->siguiente;
-		if(proceso->t_dormir <= 0) {
-			//Elevar nivel interrupcion y guardar actual (desconocido)
-			int nivel_int = fijar_nivel_int(NIVEL_3); //Inhibir int reloj mientras se manejan listas
-			
-			printk("El proceso con id = %d despierta\n", proceso->id);
-			//Cambiar el estado
-			proceso->estado = LISTO;
-			//Quitarlo de la lista dormidos
-			eliminar_elem(&lista_dormidos, proceso);
-			//Ponerlo el ultimo en la cola de listos
-			insertar_ultimo(&lista_listos, proceso);
-
-			//Volver al nivel de interrupcion anterior
-			fijar_nivel_int(nivel_int);		
-		}
-		//Pasar al siguiente elemento en la cola de dormidos
-		proceso = proceso_siguiente;
-	}
+static void mlfq_nuevo(BCP * proc){
+	proc->nivel_mlfq=0;
+}
 
-        return;
+static void mlfq_encolar(BCP * proc){
+	prio_insertar(proc, mlfq_nivel(proc));
+}
+
+static int mlfq_rodaja(BCP * proc){
+	return prio_rodaja(proc)<<proc->nivel_mlfq;
+}
+
+static int mlfq_expulsa(BCP * proc, BCP * actual){
+	return (proc->nivel<mlfq_nivel(actual));
 }
 
 /*
- * Tratamiento de llamadas al sistema
+ * Envejecimiento de MLFQ: devuelve todos los procesos al nivel superior
+ * para que los que han descendido no sufran inanicion. Los que estan en
+ * la cola de listos se mueven a su nuevo nivel.
  */
-static void tratar_llamsis(){
-	int nserv, res;
+static void mlfq_envejecer(){
+	int i;
+	BCP *proc;
+
+	for (i=0; i<MAX_PROC; i++) {
+		proc=&tabla_procs[i];
+		if ((proc->estado==NO_USADA) || (proc->nivel_mlfq==0) ||
+			proc->tiempo_real)
+			continue;
+		if (proc->estado==LISTO) {
+			prio_desencolar(proc);
+			proc->nivel_mlfq=0;
+			mlfq_encolar(proc);
+		}
+		else
+			proc->nivel_mlfq=0;
+	}
+}
 
-	nserv=leer_registro(0);
-	if (nserv<NSERVICIOS)
-		res=(tabla_servicios[nserv].fservicio)();
-	else
-		res=-1;		/* servicio no existente */
-	escribir_registro(0,res);
-	return;
+static int mlfq_tick(BCP * proc){
+	if (--ticks_envejecer<=0) {
+		ticks_envejecer=TICKS_ENVEJECIMIENTO;
+		mlfq_envejecer();
+	}
+	return (--proc->slice<=0);
+}
+
+static void mlfq_ceder(BCP * proc){
+	if ((proc->slice<=0) && (proc->nivel_mlfq<NIVELES_MLFQ-1))
+		proc->nivel_mlfq++;
+	mlfq_encolar(proc);
 }
 
 /*
- * Tratamiento de interrupciuones software
+ * Reparto entre grupos para cfs y stride. Al proceso le corresponderia
+ * peso/S de la UCP, siendo S la suma de pesos de los procesos activos, y
+ * por su grupo le corresponde (peso del grupo/W)*(peso/Sg), siendo W la
+ * suma de pesos de los grupos activos y Sg la de los procesos activos de
+ * su grupo; el avance del vruntime se escala por el cociente entre ambas.
+ * Con un solo grupo no cambia nada. Las sumas de los listos se mantienen
+ * al insertar y eliminar de la cola; el proceso en ejecucion no esta en
+ * ella, asi que se le suma aqui.
  */
-static void int_sw(){
+static unsigned long long ajustar_por_grupo(BCP * proc,
+			unsigned long long delta){
+	grupo *g=&tabla_grupos[proc->grupo];
+	unsigned long long peso, suma, suma_grupo, peso_activos;
 
-	printk("-> TRATANDO INT. SW\n");
+	peso=politica->peso(proc);
+	suma=peso_total_listos+peso;
+	suma_grupo=g->peso_listos+peso;
+	peso_activos=peso_grupos_listos+(g->n_listos ? 0 : g->peso);
 
-	return;
+	return delta*peso_activos*suma_grupo/(suma*g->peso);
 }
 
 /*
- *
- * Funcion auxiliar que crea un proceso reservando sus recursos.
- * Usada por llamada crear_proceso.
- *
+ * CFS: cada tick suma al vruntime del proceso en ejecucion una cantidad
+ * inversamente proporcional a su peso, y se elige el de menor vruntime.
  */
-static int crear_tarea(char *prog){
-	void * imagen, *pc_inicial;
-	int error=0;
-	int proc;
-	BCP *p_proc;
-
-	proc=buscar_BCP_libre();
-	if (proc==-1)
-		return -1;	/* no hay entrada libre */
+static void cfs_nuevo(BCP * proc){
+	proc->vruntime=min_vruntime;
+}
 
-	/* A rellenar el BCP ... */
-	p_proc=&(tabla_procs[proc]);
+static void cfs_encolar(BCP * proc){
+	arbol_insertar(&arbol_listos, proc);
+}
 
-	/* crea la imagen de memoria leyendo ejecutable */
-	imagen=crear_imagen(prog, &pc_inicial);
-	if (imagen)
-	{
-		p_proc->info_mem=imagen;
-		p_proc->pila=crear_pila(TAM_PILA);
-		fijar_contexto_ini(p_proc->info_mem, p_proc->pila, TAM_PILA,
-			pc_inicial,
-			&(p_proc->contexto_regs));
-		p_proc->id=proc;
-		p_proc->estado=LISTO;
+static void cfs_desencolar(BCP * proc){
+	arbol_eliminar(&arbol_listos, proc);
+}
 
-		/* lo inserta al final de cola de listos */
-		insertar_ultimo(&lista_listos, p_proc);
-		error= 0;
-	}
-	else
-		error= -1; /* fallo al crear imagen */
+static BCP * cfs_elegir(){
+	return arbol_listos.minimo;
+}
 
-	return error;
+static int cfs_expulsa(BCP * proc, BCP * actual){
+	return (proc->vruntime+CFS_GRANULARIDAD*CFS_ESCALA < actual->vruntime);
 }
 
 /*
- *
- * Rutinas que llevan a cabo las llamadas al sistema
- *	sis_crear_proceso sis_escribir
- *
+ * Actualiza min_vruntime tras cargar un tick al proceso en ejecucion.
+ * Nunca decrece.
  */
+static void actualizar_min_vruntime(BCP * proc){
+	unsigned long long minimo;
+
+	minimo=proc->vruntime;
+	if (arbol_listos.minimo && (arbol_listos.minimo->vruntime<minimo))
+		minimo=arbol_listos.minimo->vruntime;
+	if (minimo>min_vruntime)
+		min_vruntime=minimo;
+}
 
 /*
- * Tratamiento de llamada al sistema crear_proceso. Llama a la
- * funcion auxiliar crear_tarea sis_terminar_proceso
+ * Carga un tick al vruntime del proceso en ejecucion.
  */
-int sis_crear_proceso(){
-	char *prog;
-	int res;
+static int cfs_peso(BCP * proc){
+	return peso_prioridad[proc->prioridad];
+}
 
-	printk("-> PROC %d: CREAR PROCESO\n", p_proc_actual->id);
-	prog=(char *)leer_registro(1);
-	res=crear_tarea(prog);
-	return res;
+static int cfs_tick(BCP * proc){
+	proc->vruntime+=ajustar_por_grupo(proc,
+		(unsigned long long)CFS_ESCALA*CFS_PESO_DEFECTO/cfs_peso(proc));
+	actualizar_min_vruntime(proc);
+
+	if (arbol_listos.minimo && cfs_expulsa(arbol_listos.minimo, proc))
+		return 1;
+	return (--proc->slice<=0);
 }
 
 /*
- * Tratamiento de llamada al sistema escribir. Llama simplemente a la
- * funcion de apoyo escribir_ker
+ * Limita el credito que puede haber acumulado un proceso mientras
+ * estaba bloqueado para que no monopolice la UCP al despertar.
  */
-int sis_escribir()
-{
-	char *texto;
-	unsigned int longi;
+static void cfs_despertar(BCP * proc){
+	unsigned long long umbral;
 
-	texto=(char *)leer_registro(1);
-	longi=(unsigned int)leer_registro(2);
-
-	escribir_ker(texto, longi);
-	return 0;
+	umbral=CFS_UMBRAL_DESPERTAR*CFS_ESCALA;
+	umbral=(min_vruntime>umbral ? min_vruntime-umbral : 0);
+	if (proc->vruntime<umbral)
+		proc->vruntime=umbral;
 }
 
 /*
- * Tratamiento de llamada al sistema terminar_proceso. Llama a la
- * funcion auxiliar liberar_proceso
+ * Stride: el vruntime hace de pase y cada tick avanza STRIDE_ESCALA
+ * dividido por los tickets del proceso, sumando los que le prestan los
+ * procesos bloqueados en sus mutex. Se elige el de menor pase, asi que
+ * la UCP se reparte en proporcion exacta a los tickets.
  */
-int sis_terminar_proceso(){
-
-	printk("-> FIN PROCESO %d\n", p_proc_actual->id);
-
-	//3) Antes de liberar proceso hay que cerrar todos sus mutex
-	if (p_proc_actual->descriptores > 0) {
-		printk("Cerrar mutex que ha abierto el proceso\n");
-		for(int i = 0; i < NUM_MUT_PROC; i++) {
-			printk("%d\n", i);
-			cerrar_mutex(i);			
-		}
-		printk("se ha terminado de cerrar los mutex\n");
-	}
+static int stride_peso(BCP * proc){
+	return proc->tickets+proc->tickets_recibidos;
+}
 
-	liberar_proceso();
+static int stride_tick(BCP * proc){
+	proc->vruntime+=ajustar_por_grupo(proc,
+		STRIDE_ESCALA/stride_peso(proc));
+	actualizar_min_vruntime(proc);
 
-        return 0; /* no deber�a llegar aqui */
+	return (--proc->slice<=0);
 }
 
-int obtener_id_pr(){
-	int id = p_proc_actual->id;
-	printk("ID del proceso actual es: %d\n", id);
-	return id;
+/*
+ * Al despertar no se concede credito por el tiempo bloqueado: el pase
+ * se adelanta hasta min_vruntime para no alterar el reparto.
+ */
+static void stride_despertar(BCP * proc){
+	if (proc->vruntime<min_vruntime)
+		proc->vruntime=min_vruntime;
 }
 
-int dormir (unsigned int segundos){
-
-	int nivel_int;	
-	segundos = (unsigned int)leer_registro(1);
-	
-	//Guardamos interrupcion 
-	nivel_int = fijar_nivel_int(NIVEL_3);	
-
-	//Actualizamor BCP
-	p_proc_actual->estado = BLOQUEADO;
-	p_proc_actual->t_dormir = segundos*TICK;
-	BCP* p_proc_dormido = p_proc_actual; 
+/*
+ * Tabla con las politicas disponibles. Los campos siguen el orden de
+ * clase_planif: nombre nuevo encolar desencolar elegir rodaja tick
+ * despertar ceder expulsa peso (solo las que reparten entre grupos)
+ */
+static clase_planif tabla_planif[]={
+	{"fifo", nada, prio_encolar, prio_desencolar, prio_elegir,
+		prio_rodaja, nunca, nada, prio_encolar, nunca_expulsa},
+	{"rr", nada, prio_encolar, prio_desencolar, prio_elegir,
+		prio_rodaja, rr_tick, nada, prio_encolar, prio_expulsa},
+	{"mlfq", mlfq_nuevo, mlfq_encolar, prio_desencolar, prio_elegir,
+		mlfq_rodaja, mlfq_tick, nada, mlfq_ceder, mlfq_expulsa},
+	{"cfs", cfs_nuevo, cfs_encolar, cfs_desencolar, cfs_elegir,
+		prio_rodaja, cfs_tick, cfs_despertar, cfs_encolar, cfs_expulsa,
+		cfs_peso},
+	{"stride", cfs_nuevo, cfs_encolar, cfs_desencolar, cfs_elegir,
+		prio_rodaja, stride_tick, stride_despertar, cfs_encolar,
+		nunca_expulsa, stride_peso},
+	{NULL}
+};
 
+/*
+ * Selecciona la politica de planificacion. Se elige en el arranque con
+ * la variable de entorno PLANIFICADOR; si no esta definida o no
+ * corresponde con ninguna politica se usa PLANIFICADOR_DEFECTO.
+ */
+static clase_planif * buscar_planificador(char *nombre){
+	clase_planif *clase;
 
+	for (clase=tabla_planif; clase->nombre; clase++)
+		if (strcmp(clase->nombre, nombre)==0)
+			return clase;
+	return NULL;
+}
 
-	// Sacar de la lista
-	eliminar_primero(&lista_listos);
-	// Insertarlo
-	insertar_ultimo(&lista_dormidos, p_proc_dormido);
+static void iniciar_planificador(){
+	char *nombre;
+	int utilizacion;
 
-	// Restaurar interrupcion
-	fijar_nivel_int(nivel_int);
+	nombre=getenv("PLANIFICADOR");
+	if ((nombre==NULL) || ((politica=buscar_planificador(nombre))==NULL))
+		politica=buscar_planificador(PLANIFICADOR_DEFECTO);
 
+	/* porcentaje de UCP reservable por la clase de tiempo real */
+	nombre=getenv("UTILIZACION_RT");
+	if (nombre && ((utilizacion=atoi(nombre))>0) && (utilizacion<=100))
+		utilizacion_max_rt=utilizacion;
 
-	//cambio de contexto
+	printk("-> PLANIFICADOR %s (TIEMPO REAL HASTA %d%%)\n",
+		politica->nombre, utilizacion_max_rt);
+}
 
+/*
+ *
+ * Funciones de la clase de tiempo real (EDF)
+ *	edf_encolar edf_reponer
+ *
+ * Los procesos de esta clase se planifican antes que los de la politica
+ * en uso, por orden de plazo absoluto. En cada periodo disponen de un
+ * presupuesto de ticks; si lo agotan quedan retenidos hasta el siguiente
+ * periodo (ver edf_retener), de modo que no pueden acaparar la UCP.
+ *
+ */
+
+/*
+ * Inserta un BCP en la lista de tiempo real por orden de plazo. A
+ * igualdad de plazo queda detras de los que ya estaban.
+ */
+static void edf_encolar(BCP * proc){
+	BCP *ant=NULL, *paux=lista_tiempo_real.primero;
+
+	for ( ; paux && (paux->rt_vencimiento<=proc->rt_vencimiento);
+		paux=paux->siguiente)
+		ant=paux;
+
+	proc->siguiente=paux;
+	if (ant)
+		ant->siguiente=proc;
+	else
+		lista_tiempo_real.primero=proc;
+	if (paux==NULL)
+		lista_tiempo_real.ultimo=proc;
+}
+
+/*
+ * Si ya ha terminado el periodo en curso empieza uno nuevo en este tick
+ * con el presupuesto completo. Se llama cuando el proceso despierta.
+ */
+static void edf_reponer(BCP * proc){
+	if (ticks_sistema<proc->rt_activacion+proc->rt_periodo)
+		return;
+	proc->rt_activacion=ticks_sistema;
+	proc->rt_vencimiento=ticks_sistema+proc->rt_plazo;
+	proc->rt_restante=proc->rt_presupuesto;
+}
+
+/*
+ *
+ * Funciones que manejan los procesos listos a traves de la clase de
+ * tiempo real o de la politica en uso
+ *	contar_listo descontar_listo recontar_listo grupo_retener
+ *	encolar_listo insertar_listo eliminar_listo ceder_listo
+ *	primero_listo
+ *
+ * insertar_listo y eliminar_listo inhiben la interrupcion de reloj
+ * mientras modifican la cola, ya que int_reloj tambien inserta en ella
+ * al despertar procesos. encolar_listo se llama con ella ya inhibida.
+ */
+
+/*
+ * Anota en su grupo un proceso que entra en la cola de la politica, o lo
+ * quita al salir de ella, manteniendo las sumas de pesos que usa el
+ * reparto entre grupos. Las politicas sin peso cuentan 1 por proceso.
+ */
+static void contar_listo(BCP * proc){
+	grupo *g=&tabla_grupos[proc->grupo];
+
+	proc->peso_listo=(politica->peso ? politica->peso(proc) : 1);
+	if (g->n_listos++==0)
+		peso_grupos_listos+=g->peso;
+	g->peso_listos+=proc->peso_listo;
+	peso_total_listos+=proc->peso_listo;
+
+	proc->grupo_ant=NULL;
+	proc->grupo_sig=g->listos;
+	if (g->listos)
+		g->listos->grupo_ant=proc;
+	g->listos=proc;
+}
+
+static void descontar_listo(BCP * proc){
+	grupo *g=&tabla_grupos[proc->grupo];
+
+	if (--g->n_listos==0)
+		peso_grupos_listos-=g->peso;
+	g->peso_listos-=proc->peso_listo;
+	peso_total_listos-=proc->peso_listo;
+	proc->peso_listo=0;
+
+	if (proc->grupo_ant)
+		proc->grupo_ant->grupo_sig=proc->grupo_sig;
+	else
+		g->listos=proc->grupo_sig;
+	if (proc->grupo_sig)
+		proc->grupo_sig->grupo_ant=proc->grupo_ant;
+}
+
+/*
+ * Vuelve a contar a un proceso listo cuyo peso ha cambiado
+ */
+static void recontar_listo(BCP * proc){
+	if (proc->peso_listo==0)
+		return;
+	descontar_listo(proc);
+	contar_listo(proc);
+}
+
+/*
+ * Deja a un proceso cuyo grupo ha alcanzado su limite esperando en el
+ * grupo, fuera de la cola de listos, hasta el siguiente segundo.
+ */
+static void grupo_retener(BCP * proc){
+	proc->estado=BLOQUEADO;
+	insertar_ultimo(&tabla_grupos[proc->grupo].retenidos, proc);
+}
+
+static void encolar_listo(BCP * proc){
+	if (proc->tiempo_real)
+		edf_encolar(proc);
+	else if (tabla_grupos[proc->grupo].retenido)
+		grupo_retener(proc);
+	else {
+		politica->encolar(proc);
+		contar_listo(proc);
+		n_listos++;
+	}
+}
+
+static void insertar_listo(BCP * proc){
+	int nivel_int=fijar_nivel_int(NIVEL_3);
+
+	encolar_listo(proc);
+
+	fijar_nivel_int(nivel_int);
+}
+
+static void eliminar_listo(BCP * proc){
+	int nivel_int=fijar_nivel_int(NIVEL_3);
+
+	if (proc->tiempo_real)
+		eliminar_elem(&lista_tiempo_real, proc);
+	else {
+		politica->desencolar(proc);
+		descontar_listo(proc);
+		n_listos--;
+	}
+
+	fijar_nivel_int(nivel_int);
+}
+
+/*
+ * Devuelve a listos el proceso expulsado. Se invoca con la interrupcion
+ * de reloj inhibida.
+ */
+static void ceder_listo(BCP * proc){
+	if (proc->tiempo_real)
+		edf_encolar(proc);
+	else if (tabla_grupos[proc->grupo].retenido)
+		grupo_retener(proc);
+	else {
+		politica->ceder(proc);
+		contar_listo(proc);
+		n_listos++;
+	}
+}
+
+/*
+ * Devuelve el proceso listo que toca ejecutar, sin sacarlo de la cola,
+ * o NULL si no hay ninguno. Los de tiempo real van primero.
+ */
+static BCP * primero_listo(){
+	if (lista_tiempo_real.primero)
+		return lista_tiempo_real.primero;
+	return politica->elegir();
+}
+
+/*
+ *
+ * Funciones relacionadas con la planificacion
+ *	espera_int planificador solicitar_replanificacion expulsa_al_actual
+ *	prestar_tickets devolver_tickets despertar ceder_ucp_a
+ *	prioridad_heredada actualizar_prioridad
+ */
+
+/*
+ * Espera a que se produzca una interrupcion
+ */
+static void espera_int(){
+	int nivel;
+
+	printk("-> NO HAY LISTOS. ESPERA INT\n");
+
+	/* Baja al m�nimo el nivel de interrupci�n mientras espera */
+	nivel=fijar_nivel_int(NIVEL_1);
+	halt();
+	fijar_nivel_int(nivel);
+}
+
+/*
+ * Funci�n de planificacion: saca de la cola de listos el proceso que
+ * elige la politica en uso y lo pasa a ejecucion con una rodaja completa.
+ */
+static BCP * planificador(){
+	int nivel_int;
+	BCP *proc;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	while ((proc=primero_listo())==NULL)
+		espera_int();		/* No hay nada que hacer */
+
+	eliminar_listo(proc);
+
+	proc->estado=EJECUCION;
+	proc->slice=politica->rodaja(proc);
+	replanificar=0;	/* la peticion pendiente, si la hay, ya no aplica */
+
+	fijar_nivel_int(nivel_int);
+	return proc;
+}
+
+/*
+ * Pide que se expulse al proceso actual. No se cambia de contexto aqui,
+ * ya que se puede estar dentro de un manejador de interrupcion: se
+ * activa la interrupcion SW y sera int_sw quien lo haga.
+ */
+static void solicitar_replanificacion(){
+	replanificar=1;
+	activar_int_SW();
+}
+
+/*
+ * Indica si un proceso listo debe expulsar al que esta en ejecucion.
+ * Uno de tiempo real expulsa a cualquier otro de plazo posterior.
+ */
+static int expulsa_al_actual(BCP * proc){
+	if ((p_proc_actual==NULL) || (p_proc_actual->estado!=EJECUCION))
+		return 0;
+	if (proc->tiempo_real)
+		return (!p_proc_actual->tiempo_real ||
+			(proc->rt_vencimiento<p_proc_actual->rt_vencimiento));
+	if (p_proc_actual->tiempo_real)
+		return 0;
+	return politica->expulsa(proc, p_proc_actual);
+}
+
+/*
+ * Un proceso que se bloquea en un mutex presta sus tickets (incluidos
+ * los que a su vez le han prestado) al propietario, para que este lo
+ * libere antes. Solo la politica stride los tiene en cuenta.
+ */
+static void prestar_tickets(BCP * proc, BCP * receptor){
+	proc->tickets_prestados=proc->tickets+proc->tickets_recibidos;
+	proc->receptor=receptor;
+	receptor->tickets_recibidos+=proc->tickets_prestados;
+	recontar_listo(receptor);
+}
+
+static void devolver_tickets(BCP * proc){
+	if (proc->receptor==NULL)
+		return;
+	proc->receptor->tickets_recibidos-=proc->tickets_prestados;
+	recontar_listo(proc->receptor);
+	proc->receptor=NULL;
+	proc->tickets_prestados=0;
+}
+
+static void rueda_cancelar(BCP * proc);
+static void despertar_bloq_mutex();
+
+/*
+ * Pasa a listo un proceso que estaba bloqueado (dormido o en espera de
+ * un mutex), expulsando al actual si la politica lo indica. Si tenia
+ * tickets prestados los recupera. Se llama con el reloj inhibido.
+ */
+static void despertar_inhibido(BCP * proc){
+	rueda_cancelar(proc);	/* si esperaba con plazo, ya no vence */
+	proc->mutex_esperado=NULL;
+	devolver_tickets(proc);
+	proc->estado=LISTO;
+	if (proc->tiempo_real)
+		edf_reponer(proc);
+	else
+		politica->despertar(proc);
+	encolar_listo(proc);
+
+	/* si su grupo esta retenido no habra llegado a la cola de listos */
+	if ((proc->estado==LISTO) && expulsa_al_actual(proc))
+		solicitar_replanificacion();
+}
+
+/*
+ * Como despertar_inhibido, para un solo proceso y desde cualquier nivel
+ */
+static void despertar(BCP * proc){
+	int nivel_int=fijar_nivel_int(NIVEL_3);
+
+	despertar_inhibido(proc);
+	fijar_nivel_int(nivel_int);
+}
+
+/*
+ * Pasa a listos de una vez todos los procesos de una lista de espera,
+ * en una sola seccion con el reloj inhibido: solo se cambia el nivel de
+ * interrupcion al entrar y al salir, no por cada proceso. La expulsion,
+ * si alguno la provoca, se hace una sola vez en int_sw.
+ */
+static void despertar_todos(lista_BCPs *lista){
+	BCP *proc;
+	int nivel_int;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	while ((proc=lista->primero)!=NULL) {
+		eliminar_primero(lista);
+		despertar_inhibido(proc);
+	}
+	fijar_nivel_int(nivel_int);
+}
+
+/*
+ * Cesion directa: el proceso actual vuelve a listos y pasa a ejecutar
+ * el proceso listo indicado, que hereda lo que le quedaba de rodaja.
+ * El destino no pasa por la politica, por lo que ambos deben ser de la
+ * politica normal.
+ */
+static void ceder_ucp_a(BCP * destino){
+	BCP *p_proc_anterior=p_proc_actual;
+	int nivel_int, slice;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+
+	slice=p_proc_anterior->slice;
+	eliminar_listo(destino);
+	p_proc_anterior->estado=LISTO;
+	ceder_listo(p_proc_anterior);
+
+	destino->estado=EJECUCION;
+	destino->slice=(slice>0 ? slice : 1);
+	replanificar=0;
+	p_proc_actual=destino;
+
+	printk("-> C.CONTEXTO POR CESION: de %d a %d\n",
+			p_proc_anterior->id, destino->id);
+	cambio_contexto(&(p_proc_anterior->contexto_regs),
+			&(destino->contexto_regs));
+
+	fijar_nivel_int(nivel_int);
+}
+
+/*
+ * Prioridad que le corresponde a un proceso: la mejor entre su base y la
+ * del primer proceso de la cola de cada mutex que tiene cogido (las colas
+ * estan ordenadas por prioridad). Los mutex se buscan entre sus
+ * descriptores abiertos, ya que solo puede tener cogido un mutex que
+ * tenga abierto.
+ */
+static int prioridad_heredada(BCP * proc){
+	int i, prio=proc->prio_base;
+	mutex *m;
+	BCP *primero;
+
+	for (i=proc->desc_abiertos; i!=-1; i=proc->descriptores[i].sig) {
+		if (proc->descriptores[i].tipo!=OBJ_MUTEX)
+			continue;
+		m=proc->descriptores[i].objeto;
+		primero=m->lista_proc_esperando_lock.primero;
+		if ((m->propietario==proc->id) && primero &&
+			(primero->prioridad<prio))
+			prio=primero->prioridad;
+	}
+	return prio;
+}
+
+/*
+ * Recalcula la prioridad efectiva de un proceso y la propaga por la
+ * cadena de propietarios: si el proceso espera a su vez por un mutex, se
+ * recoloca en esa cola y se recalcula al propietario, y asi hasta que la
+ * prioridad no cambie. Un proceso listo se recoloca en la cola de listos.
+ * La cadena no puede tener mas de MAX_PROC eslabones.
+ */
+static void actualizar_prioridad(BCP * proc){
+	int nivel_int, prio, eslabones;
+	mutex *m;
+	lista_BCPs *cola;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	for (eslabones=0; proc && (eslabones<MAX_PROC); eslabones++) {
+		prio=prioridad_heredada(proc);
+		if (prio==proc->prioridad)
+			break;
+
+		if (proc->estado==LISTO) {
+			eliminar_listo(proc);
+			proc->prioridad=prio;
+			insertar_listo(proc);
+			if ((proc->estado==LISTO) && expulsa_al_actual(proc))
+				solicitar_replanificacion();
+		}
+		else
+			proc->prioridad=prio;
+
+		if (proc==p_proc_actual) {
+			/* si baja y hay otro listo mas prioritario, cede */
+			if (primero_listo() && expulsa_al_actual(primero_listo()))
+				solicitar_replanificacion();
+			break;
+		}
+		if ((m=proc->mutex_esperado)==NULL)
+			break;
+
+		cola=&m->lista_proc_esperando_lock;
+		eliminar_elem(cola, proc);
+		insertar_por_prioridad(cola, proc);
+		proc=(m->propietario==-1 ? NULL :
+			&tabla_procs[m->propietario]);
+	}
+	fijar_nivel_int(nivel_int);
+}
+
+/*
+ *
+ * Funciones que manejan la rueda de temporizacion
+ *	rueda_insertar rueda_cancelar rueda_avanzar
+ *
+ * Se invocan con la interrupcion de reloj inhibida.
+ */
+
+/*
+ * Inserta un BCP en la cubeta que corresponde a su t_despertar. Si vence
+ * mas alla del alcance de la rueda se deja en la ultima cubeta posible y
+ * se recoloca al llegar a ella. Las cubetas son doblemente enlazadas y
+ * cada BCP sabe en cual esta, por lo que sacarlo antes de tiempo es O(1).
+ */
+static void rueda_insertar(rueda_temp *rueda, BCP * proc){
+	unsigned long long expira=proc->t_despertar, delta;
+	int nivel;
+	BCP **cubeta;
+
+	if (expira<rueda->ticks)
+		expira=rueda->ticks;	/* ya vencido: en el siguiente tick */
+	delta=expira-rueda->ticks;
+
+	for (nivel=0; nivel<NIVELES_RUEDA-1; nivel++)
+		if (delta<(1ULL<<(BITS_RUEDA*(nivel+1))))
+			break;
+	if (delta>=(1ULL<<(BITS_RUEDA*NIVELES_RUEDA)))
+		expira=rueda->ticks+(1ULL<<(BITS_RUEDA*NIVELES_RUEDA))-1;
+
+	cubeta=&rueda->cubetas[nivel]
+		[(expira>>(BITS_RUEDA*nivel)) & (CUBETAS_RUEDA-1)];
+	proc->t_cubeta=cubeta;
+	proc->t_ant=NULL;
+	proc->t_sig=*cubeta;
+	if (*cubeta)
+		(*cubeta)->t_ant=proc;
+	*cubeta=proc;
+}
+
+/*
+ * Saca de la rueda a un proceso antes de que venza su plazo
+ */
+static void rueda_cancelar(BCP * proc){
+	if (proc->t_cubeta==NULL)
+		return;
+	if (proc->t_ant)
+		proc->t_ant->t_sig=proc->t_sig;
+	else
+		*proc->t_cubeta=proc->t_sig;
+	if (proc->t_sig)
+		proc->t_sig->t_ant=proc->t_ant;
+	proc->t_cubeta=NULL;
+}
+
+/*
+ * Procesa los ticks pendientes hasta ticks_sistema. Cuando el nivel 0 da
+ * la vuelta se reparte la cubeta que toca del nivel superior (en cascada)
+ * y despues se despiertan los procesos de la cubeta del tick actual. Se
+ * invoca desde int_reloj, asi que ya tiene el reloj inhibido.
+ */
+static void rueda_avanzar(rueda_temp *rueda){
+	int nivel, indice;
+	BCP *proc, *siguiente;
+
+	for ( ; rueda->ticks<=ticks_sistema; rueda->ticks++) {
+		for (nivel=1; nivel<NIVELES_RUEDA; nivel++) {
+			if (rueda->ticks & ((1ULL<<(BITS_RUEDA*nivel))-1))
+				break;
+			indice=(rueda->ticks>>(BITS_RUEDA*nivel)) &
+				(CUBETAS_RUEDA-1);
+			proc=rueda->cubetas[nivel][indice];
+			rueda->cubetas[nivel][indice]=NULL;
+			for ( ; proc; proc=siguiente) {
+				siguiente=proc->t_sig;
+				rueda_insertar(rueda, proc);
+			}
+		}
+
+		indice=rueda->ticks & (CUBETAS_RUEDA-1);
+		proc=rueda->cubetas[0][indice];
+		rueda->cubetas[0][indice]=NULL;
+		for ( ; proc; proc=siguiente) {
+			siguiente=proc->t_sig;
+			proc->t_cubeta=NULL;
+			if (proc->t_despertar>rueda->ticks) {
+				/* estaba fuera del alcance de la rueda */
+				rueda_insertar(rueda, proc);
+				continue;
+			}
+			if (proc->t_lista) {
+				/* vence una espera con plazo: deja su cola */
+				eliminar_elem(proc->t_lista, proc);
+				proc->t_lista=NULL;
+			}
+			despertar_inhibido(proc);
+		}
+	}
+}
+
+/*
+ * Retiene hasta el inicio de su siguiente periodo a un proceso de tiempo
+ * real que ha agotado su presupuesto. Espera en la rueda como si
+ * estuviera dormido, y al despertar edf_reponer le da un periodo nuevo.
+ */
+static void edf_retener(BCP * proc){
+	printk("-> PROC %d AGOTA SU PRESUPUESTO HASTA EL TICK %llu\n",
+		proc->id, proc->rt_activacion+proc->rt_periodo);
+	proc->estado=BLOQUEADO;
+	proc->t_despertar=proc->rt_activacion+proc->rt_periodo;
+	rueda_insertar(&rueda_dormidos, proc);
+}
+
+/*
+ *
+ * Funciones que aplican el limite de UCP de los grupos de procesos
+ *	limitar_grupo cobrar_grupo renovar_grupos
+ *
+ * Se invocan con la interrupcion de reloj inhibida.
+ */
+
+/*
+ * Retiene un grupo que ha alcanzado su limite: sus procesos listos salen
+ * de la cola y los que lleguen a ella despues esperaran en el grupo.
+ */
+static void limitar_grupo(int num){
+	BCP *proc;
+
+	printk("-> GRUPO %d ALCANZA SU LIMITE DE %d TICKS\n", num,
+		tabla_grupos[num].limite);
+	tabla_grupos[num].retenido=1;
+	while ((proc=tabla_grupos[num].listos)!=NULL) {
+		eliminar_listo(proc);
+		grupo_retener(proc);
+	}
+}
+
+/*
+ * Carga un tick al grupo del proceso en ejecucion. Devuelve !=0 si el
+ * grupo ha alcanzado su limite y el proceso debe dejar la UCP.
+ */
+static int cobrar_grupo(BCP * proc){
+	grupo *g=&tabla_grupos[proc->grupo];
+
+	g->consumidos++;
+	if ((g->limite==0) || (g->consumidos<g->limite))
+		return 0;
+	if (!g->retenido)
+		limitar_grupo(proc->grupo);
+	return 1;
+}
+
+/*
+ * Al empezar cada segundo se pone a cero el consumo de los grupos y se
+ * liberan los procesos retenidos.
+ */
+static void renovar_grupos(){
+	int i;
+	BCP *proc;
+
+	for (i=0; i<NUM_GRUPOS; i++) {
+		tabla_grupos[i].consumidos=0;
+		tabla_grupos[i].retenido=0;
+		while ((proc=tabla_grupos[i].retenidos.primero)!=NULL) {
+			eliminar_primero(&tabla_grupos[i].retenidos);
+			despertar(proc);
+		}
+	}
+}
+
+/*
+ * Saca al proceso actual de su grupo, liberando el grupo si se queda
+ * sin procesos (salvo el inicial).
+ */
+static void abandonar_grupo(){
+	grupo *g=&tabla_grupos[p_proc_actual->grupo];
+
+	if ((--g->n_procs==0) && (p_proc_actual->grupo!=GRUPO_INICIAL))
+		g->en_uso=0;
+}
+
+static void liberar_mensajes_proceso();
+
+/*
+ *
+ * Funcion auxiliar que termina proceso actual liberando sus recursos.
+ * Usada por llamada terminar_proceso y por rutinas que tratan excepciones
+ *
+ */
+static void liberar_proceso(){
+	BCP * p_proc_anterior;
+
+	liberar_imagen(p_proc_actual->info_mem); /* liberar mapa */
+
+	//3) Antes de liberar proceso hay que cerrar todos sus mutex (y los
+	//demas objetos), tambien si termina por una excepcion
+	if (p_proc_actual->n_descriptores > 0) {
+		printk("Cerrar mutex que ha abierto el proceso\n");
+		/* solo se recorren los descriptores abiertos */
+		while (p_proc_actual->desc_abiertos != -1) {
+			int i = p_proc_actual->desc_abiertos;
+
+			if (p_proc_actual->descriptores[i].tipo == OBJ_SEM)
+				cerrar_sem_desc(i);
+			else if (p_proc_actual->descriptores[i].tipo == OBJ_COND)
+				cerrar_cond_desc(i);
+			else if (p_proc_actual->descriptores[i].tipo == OBJ_RW)
+				cerrar_rw_desc(i);
+			else if (p_proc_actual->descriptores[i].tipo == OBJ_BARRERA)
+				cerrar_barrera_desc(i);
+			else if (p_proc_actual->descriptores[i].tipo == OBJ_COLA)
+				cerrar_cola_desc(i);
+			else
+				cerrar_descriptor(i);
+		}
+		printk("se ha terminado de cerrar los mutex\n");
+	}
+
+	/* los mensajes que no ha liberado se pierden */
+	liberar_mensajes_proceso();
+
+	/* la tabla de descriptores ya no tiene ninguno abierto */
+	free(p_proc_actual->descriptores);
+	p_proc_actual->descriptores=NULL;
+	p_proc_actual->tam_descriptores=0;
+
+	abandonar_grupo();
+
+	/* devuelve la reserva de tiempo real, si la tenia */
+	if (p_proc_actual->tiempo_real) {
+		densidad_rt-=p_proc_actual->rt_densidad;
+		p_proc_actual->tiempo_real=0;
+	}
+
+	p_proc_actual->estado=TERMINADO;
+
+	/* Realizar cambio de contexto */
+	p_proc_anterior=p_proc_actual;
+	p_proc_actual=planificador();
+
+	printk("-> C.CONTEXTO POR FIN: de %d a %d\n",
+			p_proc_anterior->id, p_proc_actual->id);
+
+	liberar_pila(p_proc_anterior->pila);
+	cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
+        return; /* no deber�a llegar aqui */
+}
+
+/*
+ *
+ * Funciones relacionadas con el tratamiento de interrupciones
+ *	excepciones: exc_arit exc_mem
+ *	interrupciones de reloj: int_reloj
+ *	interrupciones del terminal: int_terminal
+ *	llamadas al sistemas: llam_sis
+ *	interrupciones SW: int_sw
+ *
+ */
+
+/*
+ * Tratamiento de excepciones aritmeticas
+ */
+static void exc_arit(){
+
+	if (!viene_de_modo_usuario())
+		panico("excepcion aritmetica cuando estaba dentro del kernel");
+
+
+	printk("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
+	liberar_proceso();
+
+        return; /* no deber�a llegar aqui */
+}
+
+/*
+ * Tratamiento de excepciones en el acceso a memoria
+ */
+static void exc_mem(){
+
+	if (!viene_de_modo_usuario())
+		panico("excepcion de memoria cuando estaba dentro del kernel");
+
+
+	printk("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
+	liberar_proceso();
+
+        return; /* no deber�a llegar aqui */
+}
+
+/*
+ * Tratamiento de interrupciones de terminal
+ */
+static void int_terminal(){
+	char car;
+
+	car = leer_puerto(DIR_TERMINAL);
+	printk("-> TRATANDO INT. DE TERMINAL %c\n", car);
+
+        return;
+}
+
+/*
+ * Tratamiento de interrupciones de reloj
+ */
+static void int_reloj(){
+
+	printk("-> TRATANDO INT. DE RELOJ\n");
+
+	/* Cargar el tick al proceso en ejecucion (si lo hay: puede que se
+	   este esperando en espera_int con el proceso actual bloqueado) */
+	if ((p_proc_actual!=NULL) && (p_proc_actual->estado==EJECUCION)) {
+		if (p_proc_actual->tiempo_real) {
+			/* al agotar el presupuesto sera retenido en int_sw */
+			if (--p_proc_actual->rt_restante<=0)
+				solicitar_replanificacion();
+		}
+		else if (politica->tick(p_proc_actual) |
+			cobrar_grupo(p_proc_actual))
+			solicitar_replanificacion();
+	}
+
+	/* Cada segundo se renueva el consumo de los grupos */
+	ticks_sistema++;
+	if ((ticks_sistema%TICK)==0)
+		renovar_grupos();
+
+	/* Despertar a los dormidos cuyo plazo vence en este tick */
+	rueda_avanzar(&rueda_dormidos);
+
+        return;
+}
+
+/*
+ * Tratamiento de llamadas al sistema
+ */
+static void tratar_llamsis(){
+	int nserv, res;
+
+	nserv=leer_registro(0);
+	if (nserv<NSERVICIOS)
+		res=(tabla_servicios[nserv].fservicio)();
+	else
+		res=-1;		/* servicio no existente */
+	escribir_registro(0,res);
+	return;
+}
+
+/*
+ * Tratamiento de interrupciuones software
+ */
+static void int_sw(){
+	BCP * p_proc_anterior;
+	int nivel_int;
+
+	printk("-> TRATANDO INT. SW\n");
+
+	/* Puede que el proceso ya se haya bloqueado o terminado antes de
+	   atender la peticion, en cuyo caso planificador la habra anulado */
+	if (!replanificar)
+		return;
+	replanificar=0;
+
+	/* El proceso expulsado vuelve a listos segun su clase, salvo que
+	   sea de tiempo real y haya agotado el presupuesto del periodo */
+	p_proc_anterior=p_proc_actual;
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (p_proc_anterior->tiempo_real && (p_proc_anterior->rt_restante<=0))
+		edf_retener(p_proc_anterior);
+	else {
+		p_proc_anterior->estado=LISTO;
+		ceder_listo(p_proc_anterior);
+	}
+	fijar_nivel_int(nivel_int);
+	p_proc_actual=planificador();
+
+	if (p_proc_actual!=p_proc_anterior) {
+		printk("-> C.CONTEXTO POR EXPULSION: de %d a %d\n",
+				p_proc_anterior->id, p_proc_actual->id);
+		cambio_contexto(&(p_proc_anterior->contexto_regs),
+				&(p_proc_actual->contexto_regs));
+	}
+	return;
+}
+
+/*
+ *
+ * Funcion auxiliar que crea un proceso reservando sus recursos.
+ * Usada por llamada crear_proceso.
+ *
+ */
+static int crear_tarea(char *prog){
+	void * imagen, *pc_inicial;
+	int error=0;
+	int proc;
+	BCP *p_proc;
+
+	proc=buscar_BCP_libre();
+	if (proc==-1)
+		return -1;	/* no hay entrada libre */
+
+	/* A rellenar el BCP ... */
+	p_proc=&(tabla_procs[proc]);
+
+	/* crea la imagen de memoria leyendo ejecutable */
+	imagen=crear_imagen(prog, &pc_inicial);
+	if (imagen)
+	{
+		p_proc->info_mem=imagen;
+		p_proc->pila=crear_pila(TAM_PILA);
+		fijar_contexto_ini(p_proc->info_mem, p_proc->pila, TAM_PILA,
+			pc_inicial,
+			&(p_proc->contexto_regs));
+		p_proc->id=proc;
+		p_proc->estado=LISTO;
+		p_proc->prioridad=PRIO_DEFECTO;
+		p_proc->prio_base=PRIO_DEFECTO;
+		p_proc->mutex_esperado=NULL;
+		p_proc->mensajes=NULL;
+		p_proc->msj_pendiente=NULL;
+		p_proc->tickets=TICKETS_DEFECTO;
+		p_proc->tickets_recibidos=0;
+		p_proc->tickets_prestados=0;
+		p_proc->receptor=NULL;
+		p_proc->tiempo_real=0;
+		p_proc->t_cubeta=NULL;
+		p_proc->t_lista=NULL;
+
+		/* no tiene ningun objeto abierto: la tabla se crea al abrir uno */
+		p_proc->n_descriptores=0;
+		p_proc->descriptores=NULL;
+		p_proc->tam_descriptores=0;
+		p_proc->desc_libre=-1;
+		p_proc->desc_abiertos=-1;
+
+		/* hereda el grupo del proceso que lo crea */
+		p_proc->grupo=(p_proc_actual ? p_proc_actual->grupo :
+							GRUPO_INICIAL);
+		tabla_grupos[p_proc->grupo].n_procs++;
+		politica->nuevo(p_proc);
+
+		/* lo inserta al final de su nivel en la cola de listos */
+		insertar_listo(p_proc);
+		error= 0;
+	}
+	else
+		error= -1; /* fallo al crear imagen */
+
+	return error;
+}
+
+/*
+ *
+ * Rutinas que llevan a cabo las llamadas al sistema
+ *	sis_crear_proceso sis_escribir
+ *
+ */
+
+/*
+ * Tratamiento de llamada al sistema crear_proceso. Llama a la
+ * funcion auxiliar crear_tarea sis_terminar_proceso
+ */
+int sis_crear_proceso(){
+	char *prog;
+	int res;
+
+	printk("-> PROC %d: CREAR PROCESO\n", p_proc_actual->id);
+	prog=(char *)leer_registro(1);
+	res=crear_tarea(prog);
+	return res;
+}
+
+/*
+ * Tratamiento de llamada al sistema escribir. Llama simplemente a la
+ * funcion de apoyo escribir_ker
+ */
+int sis_escribir()
+{
+	char *texto;
+	unsigned int longi;
+
+	texto=(char *)leer_registro(1);
+	longi=(unsigned int)leer_registro(2);
+
+	escribir_ker(texto, longi);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema terminar_proceso. Llama a la
+ * funcion auxiliar liberar_proceso
+ */
+int sis_terminar_proceso(){
+
+	printk("-> FIN PROCESO %d\n", p_proc_actual->id);
+
+	liberar_proceso();
+
+        return 0; /* no deber�a llegar aqui */
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_prioridad. Cambia la prioridad
+ * base del proceso actual y devuelve la que tenia. Si tiene mutex por los
+ * que esperan procesos mas prioritarios conserva la heredada de ellos.
+ */
+int sis_fijar_prioridad(){
+	int prio, anterior;
+
+	prio=(int)leer_registro(1);
+	if ((prio<PRIO_MAX) || (prio>PRIO_MIN))
+		return -1;
+
+	anterior=p_proc_actual->prio_base;
+	p_proc_actual->prio_base=prio;
+	actualizar_prioridad(p_proc_actual);
+	return anterior;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_tickets. Cambia los tickets
+ * propios del proceso actual y devuelve los que tenia. Los prestados por
+ * otros procesos no se ven afectados.
+ */
+int sis_fijar_tickets(){
+	int tickets, anterior;
+
+	tickets=(int)leer_registro(1);
+	if ((tickets<1) || (tickets>TICKETS_MAX))
+		return -1;
+
+	anterior=p_proc_actual->tickets;
+	p_proc_actual->tickets=tickets;
+	return anterior;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_tiempo_real. Pasa el proceso
+ * actual a la clase de tiempo real con el periodo, presupuesto y plazo
+ * indicados (en ticks), o lo devuelve a la politica normal si el
+ * presupuesto es 0. Se rechaza si la suma de densidades (presupuesto/plazo)
+ * superaria utilizacion_max_rt, lo que garantiza que EDF cumple todos
+ * los plazos mientras no se supere el 100%.
+ */
+int sis_fijar_tiempo_real(){
+	unsigned int periodo, presupuesto, plazo;
+	int densidad, nivel_int;
+	BCP *proc=p_proc_actual;
+
+	periodo=(unsigned int)leer_registro(1);
+	presupuesto=(unsigned int)leer_registro(2);
+	plazo=(unsigned int)leer_registro(3);
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (presupuesto==0) {
+		if (proc->tiempo_real) {
+			densidad_rt-=proc->rt_densidad;
+			proc->tiempo_real=0;
+			politica->despertar(proc);
+			proc->slice=politica->rodaja(proc);
+		}
+	}
+	else {
+		if ((plazo<presupuesto) || (periodo<plazo)) {
+			fijar_nivel_int(nivel_int);
+			return -1;
+		}
+		/* En 64 bits: con 32 el producto desborda y la densidad sale
+		   pequena, admitiendo reservas que no caben */
+		densidad=(int)(((unsigned long long)presupuesto*1000+plazo-1)/
+			plazo);
+		if (densidad_rt-(proc->tiempo_real ? proc->rt_densidad : 0)+
+			densidad > utilizacion_max_rt*10) {
+			printk("-> PROC %d: RESERVA DE TIEMPO REAL RECHAZADA\n",
+				proc->id);
+			fijar_nivel_int(nivel_int);
+			return -1;
+		}
+		densidad_rt+=densidad-(proc->tiempo_real ? proc->rt_densidad : 0);
+		proc->rt_densidad=densidad;
+		proc->rt_periodo=periodo;
+		proc->rt_presupuesto=presupuesto;
+		proc->rt_plazo=plazo;
+		proc->rt_activacion=ticks_sistema;
+		proc->rt_vencimiento=ticks_sistema+plazo;
+		proc->rt_restante=presupuesto;
+		proc->tiempo_real=1;
+	}
+
+	/* Puede haber otro listo que ahora deba ejecutar antes */
+	if (primero_listo() && expulsa_al_actual(primero_listo()))
+		solicitar_replanificacion();
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_parametro. Cambia el valor de
+ * un parametro del nucleo y devuelve el que tenia; si el valor es
+ * negativo solo lo consulta. Los cambios de latencia y granularidad se
+ * aplican a partir de la siguiente rodaja.
+ */
+int sis_fijar_parametro(){
+	int num, valor, anterior;
+	parametro *param;
+
+	num=(int)leer_registro(1);
+	valor=(int)leer_registro(2);
+	if ((num<0) || (num>=NUM_PARAMETROS))
+		return -1;
+
+	param=&tabla_parametros[num];
+	anterior=*param->valor;
+	if (valor<0)
+		return anterior;
+	if ((valor<param->minimo) || (valor>param->maximo))
+		return -1;
+
+	*param->valor=valor;
+	printk("-> PARAMETRO %s: %d -> %d\n", param->nombre, anterior, valor);
+
+	/* si sube el limite de mutex, despierta a uno por cada hueco nuevo */
+	if (num==PARAM_MAX_MUTEX) {
+		int nivel_int=fijar_nivel_int(NIVEL_3);
+
+		for (num=mutex_creados; (num<max_mutex) && lista_bloq_mutex.primero;
+				num++)
+			despertar_bloq_mutex();
+		fijar_nivel_int(nivel_int);
+	}
+	return anterior;
+}
+
+/*
+ * Tratamiento de llamada al sistema ceder. El proceso actual vuelve a
+ * listos (al final de su nivel, o segun su vruntime en cfs y stride) y
+ * se elige otro. El cambio lo hace int_sw como en una expulsion.
+ */
+int sis_ceder(){
+	solicitar_replanificacion();
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema ceder_a. Cede el resto de la rodaja
+ * al proceso indicado, que debe estar listo. Devuelve -1 si no lo esta
+ * o si alguno de los dos es de tiempo real.
+ */
+int sis_ceder_a(){
+	int pid;
+	BCP *destino;
+
+	pid=(int)leer_registro(1);
+	if ((pid<0) || (pid>=MAX_PROC))
+		return -1;
+
+	destino=&tabla_procs[pid];
+	if ((destino->estado!=LISTO) || destino->tiempo_real ||
+		p_proc_actual->tiempo_real)
+		return -1;
+
+	ceder_ucp_a(destino);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_grupo. Crea un grupo de
+ * procesos con el peso y el limite (ticks por segundo, 0 sin limite)
+ * indicados y mete en el al proceso actual; los procesos que cree a
+ * partir de ahora lo heredaran. Devuelve el numero de grupo o -1.
+ */
+int sis_crear_grupo(){
+	int peso, limite, num, nivel_int;
+
+	peso=(int)leer_registro(1);
+	limite=(int)leer_registro(2);
+	if ((peso<1) || (peso>GRUPO_PESO_MAX) || (limite<0) || (limite>TICK))
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	for (num=0; (num<NUM_GRUPOS) && tabla_grupos[num].en_uso; num++);
+	if (num==NUM_GRUPOS) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	memset(&tabla_grupos[num], 0, sizeof(grupo));
+	tabla_grupos[num].en_uso=1;
+	tabla_grupos[num].peso=peso;
+	tabla_grupos[num].limite=limite;
+
+	abandonar_grupo();
+	p_proc_actual->grupo=num;
+	tabla_grupos[num].n_procs=1;
+	fijar_nivel_int(nivel_int);
+
+	printk("-> PROC %d: CREA GRUPO %d (PESO %d LIMITE %d)\n",
+		p_proc_actual->id, num, peso, limite);
+	return num;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_grupo. Cambia el peso y el
+ * limite del grupo al que pertenece el proceso actual; no se permite
+ * sobre otros grupos, que uno no pueda limitar a otro. Un limite nuevo
+ * se aplica desde el siguiente tick, y los procesos ya retenidos siguen
+ * esperando al siguiente segundo.
+ */
+int sis_fijar_grupo(){
+	int num, peso, limite, nivel_int;
+
+	num=(int)leer_registro(1);
+	peso=(int)leer_registro(2);
+	limite=(int)leer_registro(3);
+	if ((num<0) || (num>=NUM_GRUPOS) || (num!=p_proc_actual->grupo) ||
+		(peso<1) || (peso>GRUPO_PESO_MAX) || (limite<0) || (limite>TICK))
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (tabla_grupos[num].n_listos)
+		peso_grupos_listos=peso_grupos_listos-tabla_grupos[num].peso+peso;
+	tabla_grupos[num].peso=peso;
+	tabla_grupos[num].limite=limite;
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+int obtener_id_pr(){
+	int id = p_proc_actual->id;
+	printk("ID del proceso actual es: %d\n", id);
+	return id;
+}
+
+/*
+ * Funcion auxiliar que bloquea al proceso actual hasta el tick absoluto
+ * indicado. Usada por dormir, dormir_ms y dormir_hasta.
+ */
+static void dormir_hasta_tick(unsigned long long tick){
+
+	int nivel_int;	
+	
+	//Guardamos interrupcion 
+	nivel_int = fijar_nivel_int(NIVEL_3);	
+
+	//Actualizamor BCP
+	p_proc_actual->estado = BLOQUEADO;
+	p_proc_actual->t_despertar = tick;
+	BCP* p_proc_dormido = p_proc_actual; 
+
+
+
+	// Insertarlo en la rueda (ya no esta en listos: salio al ser planificado)
+	rueda_insertar(&rueda_dormidos, p_proc_dormido);
+
+
+	//cambio de contexto
+
+	p_proc_actual=planificador();
+	cambio_contexto(&(p_proc_dormido->contexto_regs), &(p_proc_actual->contexto_regs));
+
+	// Restaurar interrupcion
+	fijar_nivel_int(nivel_int);
+}
+
+int dormir (unsigned int segundos){
+
+	segundos = (unsigned int)leer_registro(1);
+	dormir_hasta_tick(ticks_sistema + (unsigned long long)segundos*TICK);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema dormir_ms. El plazo se redondea
+ * hacia arriba al siguiente tick.
+ */
+int sis_dormir_ms(){
+	unsigned int ms;
+
+	ms=(unsigned int)leer_registro(1);
+	dormir_hasta_tick(ticks_sistema + ((unsigned long long)ms*TICK+999)/1000);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema dormir_hasta. Recibe un tick
+ * absoluto (como los que devuelve obtener_ticks), lo que permite hacer
+ * bucles periodicos sin deriva. El usuario solo ve los 32 bits bajos del
+ * contador, asi que el plazo es el tick de 64 bits con esos bits mas
+ * cercano al actual: como mucho 2^31 ticks por delante o por detras. Si
+ * ya ha pasado no se bloquea.
+ */
+int sis_dormir_hasta(){
+	unsigned int tick;
+	unsigned long long plazo;
+
+	tick=(unsigned int)leer_registro(1);
+	plazo=ticks_sistema+(int)(tick-(unsigned int)ticks_sistema);
+	if (plazo>ticks_sistema)
+		dormir_hasta_tick(plazo);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema obtener_ticks. Devuelve los 32 bits
+ * bajos de los ticks transcurridos desde el arranque, que el usuario
+ * trata como un unsigned int que da la vuelta.
+ */
+int sis_obtener_ticks(){
+	return (int)(unsigned int)ticks_sistema;
+}
+
+/*
+ *
+ * Rutinas de futex: colas de espera indexadas por la direccion de una
+ * palabra de la memoria de usuario. Todos los procesos comparten espacio
+ * de direcciones, asi que el nucleo puede leer la palabra directamente.
+ * La biblioteca solo las invoca cuando hay contencion (ver usuario/lib/
+ * futex.c).
+ *	sis_futex_wait sis_futex_wake
+ *
+ */
+
+static lista_BCPs * cola_futex(int *dir){
+	return &colas_futex[((unsigned long)dir>>2)%TAM_TABLA_FUTEX];
+}
+
+/*
+ * Tratamiento de llamada al sistema futex_wait. Bloquea al proceso si la
+ * palabra sigue valiendo lo indicado; la comprobacion y el bloqueo se
+ * hacen con el reloj inhibido, por lo que no se puede perder un
+ * futex_wake. Devuelve -1 sin bloquearse si el valor ha cambiado.
+ */
+int sis_futex_wait(){
+	int *dir, valor, nivel_int;
+	BCP *p_proc_bloq;
+
+	dir=(int *)leer_registro(1);
+	valor=(int)leer_registro(2);
+	if (dir==NULL)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (*dir!=valor) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	p_proc_actual->estado=BLOQUEADO;
+	p_proc_actual->futex_dir=dir;
+	insertar_ultimo(cola_futex(dir), p_proc_actual);
+
+	p_proc_bloq=p_proc_actual;
+	p_proc_actual=planificador();
+	cambio_contexto(&(p_proc_bloq->contexto_regs),
+			&(p_proc_actual->contexto_regs));
+
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema futex_wake. Despierta, por orden de
+ * llegada, hasta n procesos bloqueados en la direccion indicada y
+ * devuelve cuantos ha despertado.
+ */
+int sis_futex_wake(){
+	int *dir, n, despertados=0, nivel_int;
+	lista_BCPs *cola;
+	BCP *proc, *siguiente;
+
+	dir=(int *)leer_registro(1);
+	n=(int)leer_registro(2);
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	cola=cola_futex(dir);
+	for (proc=cola->primero; proc && (despertados<n); proc=siguiente) {
+		siguiente=proc->siguiente;
+		if (proc->futex_dir!=dir)
+			continue;
+		eliminar_elem(cola, proc);
+		proc->futex_dir=NULL;
+		despertar(proc);
+		despertados++;
+	}
+	fijar_nivel_int(nivel_int);
+	return despertados;
+}
+
+/*
+ *
+ * Funciones que manejan el espacio de nombres de objetos del nucleo
+ *	hash_nombre buscar_nombre registrar_nombre borrar_nombre
+ *
+ * Buscar, registrar y borrar son O(1) en promedio sea cual sea el numero
+ * de objetos con nombre. Se invocan con la interrupcion de reloj inhibida
+ * porque un proceso puede bloquearse entre la busqueda y el registro.
+ */
+
+/*
+ * Funcion hash FNV-1a sobre el nombre
+ */
+static unsigned int hash_nombre(char *nombre){
+	unsigned int hash=2166136261U;
+
+	for ( ; *nombre; nombre++)
+		hash=(hash^(unsigned char)*nombre)*16777619U;
+	return hash;
+}
+
+/*
+ * Devuelve la entrada con ese nombre, sea cual sea su clase, o NULL
+ */
+static nombre_obj * buscar_nombre(char *nombre){
+	unsigned int hash=hash_nombre(nombre);
+	nombre_obj *ent;
+
+	for (ent=tabla_nombres[hash&(TAM_TABLA_NOMBRES-1)]; ent; ent=ent->sig)
+		if ((ent->hash==hash) && (strcmp(ent->texto, nombre)==0))
+			return ent;
+	return NULL;
+}
+
+/*
+ * Copia el nombre en la entrada del objeto y la inserta en la tabla. El
+ * llamante ha comprobado la longitud y que el nombre no existe.
+ */
+static void registrar_nombre(nombre_obj *ent, char *nombre, int tipo,
+				void *objeto){
+	nombre_obj **cubeta;
+
+	strcpy(ent->texto, nombre);
+	ent->hash=hash_nombre(nombre);
+	ent->tipo=tipo;
+	ent->objeto=objeto;
+
+	cubeta=&tabla_nombres[ent->hash&(TAM_TABLA_NOMBRES-1)];
+	ent->sig=*cubeta;
+	*cubeta=ent;
+}
+
+static void borrar_nombre(nombre_obj *ent){
+	nombre_obj **enlace;
+
+	for (enlace=&tabla_nombres[ent->hash&(TAM_TABLA_NOMBRES-1)];
+		*enlace!=ent; enlace=&(*enlace)->sig);
+	*enlace=ent->sig;
+	ent->texto[0]='\0';
+}
+
+/*
+ *
+ * Funciones auxiliares de los mutex
+ *	nuevo_slab_mutex descriptor_mutex liberar_mutex
+ *
+ */
+
+/*
+ * Reserva un slab de mutex y encadena todos sus mutex en la lista de
+ * libres. Devuelve -1 si no se puede reservar.
+ */
+static int nuevo_slab_mutex(){
+	slab_mutex *slab;
+	int i;
+
+	if (n_slabs_mutex==MAX_MUT/MUTEX_POR_SLAB)
+		return -1;
+	if ((slab=malloc(sizeof(slab_mutex)))==NULL)
+		return -1;
+
+	for (i=0; i<MUTEX_POR_SLAB; i++) {
+		slab->objetos[i].nombre.texto[0]='\0';
+		slab->objetos[i].abierto=0;
+		slab->objetos[i].locked=0;
+		slab->objetos[i].propietario=-1;
+		slab->objetos[i].lista_proc_esperando_lock.primero=NULL;
+		slab->objetos[i].lista_proc_esperando_lock.ultimo=NULL;
+		slab->objetos[i].sig_libre=&slab->objetos[i+1];
+	}
+	slab->objetos[MUTEX_POR_SLAB-1].sig_libre=mutex_libre;
+	mutex_libre=&slab->objetos[0];
+	slabs_mutex[n_slabs_mutex++]=slab;
+	return 0;
+}
+
+/*
+ * Saca un mutex de la lista de libres, reservando otro slab si esta
+ * vacia, o devuelve NULL si no se puede. El llamante ha comprobado que
+ * no se ha llegado a max_mutex. Un mutex reciclado ya esta libre y sin
+ * procesos esperando: solo se ponen a cero sus estadisticas.
+ */
+static mutex * descriptor_mutex(){
+	mutex *m;
+
+	if ((mutex_libre==NULL) && (nuevo_slab_mutex()<0))
+		return NULL;
+	m=mutex_libre;
+	mutex_libre=m->sig_libre;
+	memset(&m->estad, 0, sizeof(estad_mutex));
+	return m;
+}
+
+/*
+ * Devuelve a la lista de libres un mutex que ya no tiene abierto ningun
+ * proceso, borrando su nombre
+ */
+static void liberar_mutex(mutex *m){
+	borrar_nombre(&m->nombre);
+	m->locked=0;
+	m->propietario=-1;
+	m->sig_libre=mutex_libre;
+	mutex_libre=m;
+}
+
+/*
+ * Anota que el mutex acaba de cambiar de propietario
+ */
+static void anotar_adquisicion(mutex *m){
+	m->estad.adquisiciones++;
+	m->t_cogido=ticks_sistema;
+}
+
+/*
+ * Suelta un mutex que el proceso actual tenia cogido. Si hay procesos
+ * esperando se lo pasa directamente al primero, que al despertar ya es
+ * el propietario y no compite con los que llegan despues; los demas
+ * pasan a prestar sus tickets al nuevo propietario, que hereda su
+ * prioridad. Se llama con el reloj inhibido.
+ */
+static void traspasar_mutex(mutex *m){
+	BCP *nuevo, *proc;
+	unsigned int retenido;
+
+	retenido=ticks_sistema-m->t_cogido;
+	m->estad.retencion_total+=retenido;
+	if (retenido>m->estad.retencion_max)
+		m->estad.retencion_max=retenido;
+
+	nuevo=m->lista_proc_esperando_lock.primero;
+	if (nuevo==NULL) {
+		m->locked=0;
+		m->propietario=-1;
+		return;
+	}
+
+	eliminar_primero(&m->lista_proc_esperando_lock);
+	m->locked=1;
+	m->propietario=nuevo->id;
+	anotar_adquisicion(m);
+	for (proc=m->lista_proc_esperando_lock.primero; proc;
+			proc=proc->siguiente) {
+		devolver_tickets(proc);
+		prestar_tickets(proc, nuevo);
+	}
+	despertar(nuevo);
+	actualizar_prioridad(nuevo);
+}
+
+/*
+ * Despierta a un solo proceso de los bloqueados en crear_mutex porque no
+ * quedaba ningun mutex libre. Se llama por cada mutex que se libera.
+ */
+static void despertar_bloq_mutex(){
+	BCP *proc=lista_bloq_mutex.primero;
+
+	if (proc==NULL)
+		return;
+	eliminar_primero(&lista_bloq_mutex);
+	despertar(proc);
+	printk("Se ha desbloqueado el proceso\n");
+}
+
+/*
+ *
+ * Funciones que manejan la tabla de descriptores del proceso actual
+ *	objeto_de_descriptor descriptor_libre
+ *	ocupar_descriptor liberar_descriptor
+ *
+ * La tabla se crea con el primer objeto que abre el proceso y duplica su
+ * tamano cuando se llena, hasta max_descriptores. Los descriptores
+ * libres forman una lista, por lo que obtener uno y liberarlo es O(1).
+ */
+
+/*
+ * Devuelve el objeto al que se refiere un descriptor del proceso actual,
+ * o NULL si el descriptor no es valido o es de otra clase de objeto
+ */
+static void * objeto_de_descriptor(int desc, int tipo){
+	if ((desc<0) || (desc>=p_proc_actual->tam_descriptores) ||
+		(p_proc_actual->descriptores[desc].tipo!=tipo))
+		return NULL;
+	return p_proc_actual->descriptores[desc].objeto;
+}
+
+/*
+ * Devuelve un descriptor libre del proceso actual, sin ocuparlo, o -1 si
+ * ya tiene abiertos max_descriptores. Si no queda ninguno amplia la tabla.
+ */
+int descriptor_libre () {
+	descriptor *tabla;
+	int i, tam=p_proc_actual->tam_descriptores;
+
+	if (p_proc_actual->desc_libre!=-1)
+		return p_proc_actual->desc_libre;
+
+	if (tam>=max_descriptores)
+		return -1;
+	tam=(tam ? 2*tam : NUM_MUT_PROC);
+	if (tam>max_descriptores)
+		tam=max_descriptores;
+	tabla=realloc(p_proc_actual->descriptores, tam*sizeof(descriptor));
+	if (tabla==NULL)
+		return -1;
+
+	for (i=p_proc_actual->tam_descriptores; i<tam; i++) {
+		tabla[i].tipo=0;
+		tabla[i].sig=i+1;
+	}
+	tabla[tam-1].sig=-1;
+	p_proc_actual->desc_libre=p_proc_actual->tam_descriptores;
+	p_proc_actual->descriptores=tabla;
+	p_proc_actual->tam_descriptores=tam;
+	return p_proc_actual->desc_libre;
+}
+
+/*
+ * Ocupa el descriptor devuelto por descriptor_libre con un objeto
+ */
+static void ocupar_descriptor(int desc, int tipo, void *objeto){
+	descriptor *d=&p_proc_actual->descriptores[desc];
+
+	p_proc_actual->desc_libre=d->sig;
+	d->tipo=tipo;
+	d->objeto=objeto;
+	d->uso=0;
+	d->ant=-1;
+	d->sig=p_proc_actual->desc_abiertos;
+	if (d->sig!=-1)
+		p_proc_actual->descriptores[d->sig].ant=desc;
+	p_proc_actual->desc_abiertos=desc;
+	p_proc_actual->n_descriptores++;
+}
+
+/*
+ * Devuelve un descriptor abierto del proceso actual a la lista de libres
+ */
+static void liberar_descriptor(int desc){
+	descriptor *tabla=p_proc_actual->descriptores;
+
+	if (tabla[desc].ant!=-1)
+		tabla[tabla[desc].ant].sig=tabla[desc].sig;
+	else
+		p_proc_actual->desc_abiertos=tabla[desc].sig;
+	if (tabla[desc].sig!=-1)
+		tabla[tabla[desc].sig].ant=tabla[desc].ant;
+
+	tabla[desc].tipo=0;
+	tabla[desc].sig=p_proc_actual->desc_libre;
+	p_proc_actual->desc_libre=desc;
+	p_proc_actual->n_descriptores--;
+}
+
+int crear_mutex (char *nombre, int tipo){
+	printk("Creando mutex\n");
+	nombre=(char *)leer_registro(1);
+	tipo=(int)leer_registro(2);
+
+	if(strlen(nombre) > MAX_NOM_MUT){
+		return -1;
+	}
+
+	int nivel_nombres = fijar_nivel_int(NIVEL_3);
+	if(buscar_nombre(nombre) != NULL){
+		fijar_nivel_int(nivel_nombres);
+		return -1;
+	}
+
+	int descriptor_proc = descriptor_libre();
+	if(descriptor_proc == -1) {
+		fijar_nivel_int(nivel_nombres);
+		printk("El proceso no tiene descriptores libres\n");
+		return -1; 
+	}
+
+	
+	//el limite max_mutex se puede cambiar: hasta el se reservan slabs
+	while(mutex_creados>=max_mutex) {
+
+		int nivel_int = fijar_nivel_int(NIVEL_3);
+
+		p_proc_actual->estado=BLOQUEADO;
+
+		insertar_ultimo(&lista_bloq_mutex, p_proc_actual);
+
+		BCP* p_proc_bloq = p_proc_actual;
+		p_proc_actual=planificador();
+
+		cambio_contexto(&(p_proc_bloq->contexto_regs), &(p_proc_actual->contexto_regs));
+		fijar_nivel_int(nivel_int);
+
+		//Mientras estaba bloqueado otro puede haberlo creado
+		if(buscar_nombre(nombre) != NULL){
+			//no usa el mutex libre por el que le despertaron
+			if(mutex_creados < max_mutex) {
+				despertar_bloq_mutex();
+			}
+			fijar_nivel_int(nivel_nombres);
+			return -1;
+		}
+	}
+	
+
+	mutex *descriptor_mut = descriptor_mutex();
+	if(descriptor_mut == NULL) {
+		fijar_nivel_int(nivel_nombres);
+		printk("No se puede reservar memoria para el mutex\n");
+		return -1;
+	}
+
+	ocupar_descriptor(descriptor_proc, OBJ_MUTEX, descriptor_mut);
+
+	registrar_nombre(&descriptor_mut->nombre, nombre,
+				OBJ_MUTEX, descriptor_mut);
+	descriptor_mut->tipo = tipo;
+	descriptor_mut->abierto++;
+	mutex_creados++;
+	fijar_nivel_int(nivel_nombres);
+
+	printk("Mutex creado correctamente\n");
+	return descriptor_proc; 
+}
+
+
+
+int abrir_mutex(char *nombre) {
+	printk("Abriendo mutex\n");
+	nombre=(char *)leer_registro(1);
+
+	if(strlen(nombre) > MAX_NOM_MUT){
+		return -1;
+	}
+
+	
+
+	int nivel_nombres = fijar_nivel_int(NIVEL_3);
+	nombre_obj *ent = buscar_nombre(nombre);
+	if((ent == NULL) || (ent->tipo != OBJ_MUTEX)) {
+		fijar_nivel_int(nivel_nombres);
+		printk("No se ha encontrado un mutex con este nombre\n");
+		return -1;
+	}
+
+	int descriptor_proc = descriptor_libre();
+	if(descriptor_proc == -1) {
+		fijar_nivel_int(nivel_nombres);
+		printk("El proceso no tiene descriptores libres\n");
+		return -1; 
+	}
+
+	
+	mutex *descriptor_mut = ent->objeto;
+
+
+	ocupar_descriptor(descriptor_proc, OBJ_MUTEX, descriptor_mut);
+
+	descriptor_mut->abierto++;
+	fijar_nivel_int(nivel_nombres);
+
+	printk("Mutex abierto correctamente\n");
+	return descriptor_proc; 
+}
+
+
+
+
+/*
+ * Indica si lock debe ceder la UCP al propietario del mutex en vez de
+ * bloquearse: solo si esta activado ceder_al_propietario y el
+ * propietario esta listo (fue expulsado con el mutex cogido).
+ */
+static int cede_al_propietario(mutex *mutexid){
+	BCP *propietario=&tabla_procs[mutexid->propietario];
+
+	return (ceder_al_propietario && (propietario->estado==LISTO) &&
+		!propietario->tiempo_real && !p_proc_actual->tiempo_real);
+}
+
+/*
+ * Bloquea al proceso actual en la cola del mutex hasta que lo despierten
+ * o, si tiene plazo, hasta ese tick. Se llama con el reloj inhibido.
+ * Devuelve 0 si vencio el plazo y 1 si no.
+ */
+static int esperar_mutex(mutex *mutexid, unsigned long long plazo){
+	BCP* p_proc_bloq = p_proc_actual;
+	BCP* proc;
+	estad_mutex* estad = &mutexid->estad;
+	unsigned long long inicio = ticks_sistema;
+	unsigned int en_cola = 0;
+
+	p_proc_actual->estado=BLOQUEADO;
+	insertar_por_prioridad(&(mutexid->lista_proc_esperando_lock), p_proc_actual);
+	for (proc = mutexid->lista_proc_esperando_lock.primero; proc; proc = proc->siguiente)
+		en_cola++;
+	if (en_cola > estad->cola_max)
+		estad->cola_max = en_cola;
+	prestar_tickets(p_proc_actual, &tabla_procs[mutexid->propietario]);
+
+	/* el propietario hereda la prioridad si es mejor que la suya */
+	p_proc_actual->mutex_esperado=mutexid;
+	actualizar_prioridad(&tabla_procs[mutexid->propietario]);
+	if (plazo != SIN_PLAZO) {
+		p_proc_actual->t_despertar=plazo;
+		p_proc_actual->t_lista=&(mutexid->lista_proc_esperando_lock);
+		rueda_insertar(&rueda_dormidos, p_proc_actual);
+	}
+
+	p_proc_actual=planificador();
+	cambio_contexto(&(p_proc_bloq->contexto_regs), &(p_proc_actual->contexto_regs));
+
+	/* la rueda borra t_lista cuando es ella quien lo despierta */
+	if ((plazo != SIN_PLAZO) && (p_proc_actual->t_lista == NULL)) {
+		/* el propietario deja de heredar de este proceso */
+		if (mutexid->propietario != -1)
+			actualizar_prioridad(&tabla_procs[mutexid->propietario]);
+		return 0;
+	}
+	p_proc_actual->t_lista=NULL;
+
+	estad->con_espera++;
+	estad->espera_total += ticks_sistema-inicio;
+	if (ticks_sistema-inicio > estad->espera_max)
+		estad->espera_max = ticks_sistema-inicio;
+	return 1;
+}
+
+/*
+ * Coge el mutex para el proceso actual esperando como mucho hasta el
+ * tick plazo (SIN_PLAZO para esperar lo que haga falta, o el tick
+ * actual para no esperar). Devuelve -1 si no lo consigue.
+ */
+static int adquirir_mutex(mutex *mutexid, unsigned long long plazo) {
+	int proceso_esperando = 1; 
+
+	while (proceso_esperando) {
+
+		
+		if(mutexid->locked > 0) {
+			if(mutexid->propietario == p_proc_actual->id) {
+				if((mutexid->tipo) == RECURSIVO) {
+					mutexid->locked++;
+					proceso_esperando = 0;
+				}
+				else {
+					return -1;
+				}
+			}
+			
+			else if (ticks_sistema >= plazo) {
+				return -1;
+			}
+			
+			else if (cede_al_propietario(mutexid)) {
+				ceder_ucp_a(&tabla_procs[mutexid->propietario]);
+			}
+			
+			else {
+				int nivel_int = fijar_nivel_int(NIVEL_3);
+				int a_tiempo = esperar_mutex(mutexid, plazo);
+
+				fijar_nivel_int(nivel_int);
+				if (!a_tiempo) {
+					printk("Vence la espera por el mutex\n");
+					return -1;
+				}
+				//al despertarlo ya le han traspasado el mutex
+				proceso_esperando = 0;
+			} 
+		} 
+		
+		else {
+			mutexid->locked++;
+			anotar_adquisicion(mutexid);
+			proceso_esperando = 0;
+		} 
+	} 
+
+	mutexid->propietario = p_proc_actual->id;
+	return 0;
+}
+
+int lock (unsigned int mutexid) {
+	printk("Haciendo lock\n");
+	int desc_proc=(unsigned int)leer_registro(1); 
+	mutex *mut = objeto_de_descriptor(desc_proc, OBJ_MUTEX);
+
+	if(mut == NULL) {
+		printk("El mutex no existe \n");
+		return -1;
+	}
+
+	if (adquirir_mutex(mut, SIN_PLAZO) < 0) {
+		return -1;
+	}
+	printk("Lock realizado sobre mutex\n");
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema trylock. Como lock, pero si el mutex
+ * lo tiene otro proceso devuelve -1 sin esperar.
+ */
+int trylock () {
+	mutex *mutexid;
+
+	mutexid = objeto_de_descriptor((int)leer_registro(1), OBJ_MUTEX);
+	if(mutexid == NULL) {
+		return -1;
+	}
+	return adquirir_mutex(mutexid, ticks_sistema);
+}
+
+/*
+ * Tratamiento de llamada al sistema lock_timeout. Como lock, pero deja de
+ * esperar pasados los milisegundos indicados y devuelve -1.
+ */
+int lock_timeout () {
+	mutex *mutexid;
+	unsigned int ms;
+
+	mutexid = objeto_de_descriptor((int)leer_registro(1), OBJ_MUTEX);
+	ms = (unsigned int)leer_registro(2);
+	if(mutexid == NULL) {
+		return -1;
+	}
+	return adquirir_mutex(mutexid,
+		ticks_sistema + ((unsigned long long)ms*TICK+999)/1000);
+}
+
+/*
+ * Tratamiento de llamada al sistema estadisticas_mutex. Busca el primer
+ * mutex en uso a partir de la posicion indicada y copia su nombre y sus
+ * estadisticas en la estructura del usuario. Devuelve la posicion, con
+ * lo que se pueden recorrer todos empezando por 0, o -1 si no hay mas o
+ * no se pasa estructura.
+ */
+int estadisticas_mutex () {
+	int m;
+	estad_mutex *est, copia;
+
+	m = (int)leer_registro(1);
+	est = (estad_mutex *)leer_registro(2);
+	if ((m < 0) || (est == NULL)) {
+		return -1;
+	}
+
+	int nivel_int = fijar_nivel_int(NIVEL_3);
+	for ( ; m < n_slabs_mutex*MUTEX_POR_SLAB; m++) {
+		mutex *mut = &slabs_mutex[m/MUTEX_POR_SLAB]->objetos[m%MUTEX_POR_SLAB];
+
+		if (mut->abierto > 0) {
+			copia = mut->estad;
+			strcpy(copia.nombre, mut->nombre.texto);
+			fijar_nivel_int(nivel_int);
+			/* se copia al usuario con el reloj ya habilitado */
+			*est = copia;
+			return m;
+		}
+	}
+	fijar_nivel_int(nivel_int);
+	return -1;
+}
+
+
+int unlock (unsigned int mutexid) {
+
+	int desc_proc=(unsigned int)leer_registro(1); 
+	mutex *mut = objeto_de_descriptor(desc_proc, OBJ_MUTEX);
+
+	
+	if((mut == NULL) || (mut->abierto == 0)) {
+		return -1;
+	}
+
+	
+	if((mut->locked == 0) ||
+		(mut->propietario != p_proc_actual->id)) {
+		return -1;
+	}
+
+	//un mutex recursivo solo se suelta al deshacer todos los lock
+	if(mut->locked == 1) {
+		int nivel_int = fijar_nivel_int(NIVEL_3);
+
+		traspasar_mutex(mut);
+		actualizar_prioridad(p_proc_actual);
+
+		fijar_nivel_int(nivel_int);
+	}
+	else {
+		mut->locked--;
+	}
+
+	printk("Unlock realizado correctamente\n");
+	return 0;
+}
+
+
+/*
+ * Cierra un descriptor de mutex del proceso actual. Usada por la llamada
+ * cerrar_mutex y al terminar el proceso.
+ */
+int cerrar_descriptor (unsigned int mutexid) {
+
+	mutex *desc_mut = objeto_de_descriptor(mutexid, OBJ_MUTEX);
+
+	if(desc_mut == NULL) {
+		return -1;
+	}
+
+	
+	liberar_descriptor(mutexid);
+
+	
+	int nivel_int = fijar_nivel_int(NIVEL_3);
+
+	//si lo tenia cogido pasa al primero que espera, aunque fuera recursivo
+	if(desc_mut->propietario == p_proc_actual->id) {
+		traspasar_mutex(desc_mut);
+		actualizar_prioridad(p_proc_actual);
+	}
+	desc_mut->abierto--;
+
+	
+	if(desc_mut->abierto <= 0) {
+		liberar_mutex(desc_mut);
+		mutex_creados--;
+		//un mutex libre: basta con despertar a uno
+		if(mutex_creados < max_mutex) {
+			despertar_bloq_mutex();
+		}
+	}
+
+	fijar_nivel_int(nivel_int);
+
+
+
+	return 0;
+}
+
+int cerrar_mutex (unsigned int mutexid) {
+	mutexid=(unsigned int)leer_registro(1);
+	return cerrar_descriptor(mutexid);
+}
+
+/*
+ *
+ * Rutinas de los semaforos contadores
+ *	iniciar_sem crear_sem abrir_sem wait_sem post_sem cerrar_sem
+ *
+ * Comparten con los mutex el espacio de nombres y los descriptores de
+ * cada proceso. Se manipulan con el reloj inhibido, ya que post_sem
+ * despierta procesos.
+ */
+
+/*
+ * Encadena todos los semaforos en la lista de libres
+ */
+static void iniciar_sem(){
+	int i;
+
+	for (i=0; i<NUM_SEM; i++)
+		array_sem[i].sig_libre=i+1;
+	array_sem[NUM_SEM-1].sig_libre=-1;
+	sem_libre=0;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_sem. Crea un semaforo con el
+ * nombre y valor inicial indicados y devuelve un descriptor, o -1 si el
+ * nombre es demasiado largo o ya existe, o no quedan descriptores o
+ * semaforos.
+ */
+int crear_sem(){
+	char *nombre;
+	int valor, desc, s, nivel_int;
+
+	nombre=(char *)leer_registro(1);
+	valor=(int)leer_registro(2);
+	if ((strlen(nombre)>MAX_NOM_MUT) || (valor<0))
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((buscar_nombre(nombre)!=NULL) || ((desc=descriptor_libre())==-1) ||
+		(sem_libre==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	s=sem_libre;
+	sem_libre=array_sem[s].sig_libre;
+	registrar_nombre(&array_sem[s].nombre, nombre, OBJ_SEM, &array_sem[s]);
+	array_sem[s].contador=valor;
+	array_sem[s].abierto=1;
+
+	ocupar_descriptor(desc, OBJ_SEM, &array_sem[s]);
+	fijar_nivel_int(nivel_int);
+
+	printk("-> PROC %d: CREA SEMAFORO %s (%d)\n", p_proc_actual->id,
+		nombre, valor);
+	return desc;
+}
+
+/*
+ * Tratamiento de llamada al sistema abrir_sem. Devuelve un descriptor
+ * del semaforo con ese nombre, o -1.
+ */
+int abrir_sem(){
+	char *nombre;
+	int desc, nivel_int;
+	nombre_obj *ent;
+
+	nombre=(char *)leer_registro(1);
+	if (strlen(nombre)>MAX_NOM_MUT)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	ent=buscar_nombre(nombre);
+	if ((ent==NULL) || (ent->tipo!=OBJ_SEM) ||
+		((desc=descriptor_libre())==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	ocupar_descriptor(desc, OBJ_SEM, ent->objeto);
+	((semaforo *)ent->objeto)->abierto++;
+	fijar_nivel_int(nivel_int);
+	return desc;
+}
+
+/*
+ * Tratamiento de llamada al sistema wait_sem. Si el contador es positivo
+ * lo decrementa; si no, bloquea al proceso al final de la cola.
+ */
+int wait_sem(){
+	semaforo *s;
+	int nivel_int;
+	BCP *p_proc_bloq;
+
+	s=objeto_de_descriptor((int)leer_registro(1), OBJ_SEM);
+	if (s==NULL)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (s->contador>0)
+		s->contador--;
+	else {
+		/* post_sem le pasa la unidad directamente al despertarlo */
+		p_proc_actual->estado=BLOQUEADO;
+		insertar_ultimo(&s->esperando, p_proc_actual);
+
+		p_proc_bloq=p_proc_actual;
+		p_proc_actual=planificador();
+		cambio_contexto(&(p_proc_bloq->contexto_regs),
+				&(p_proc_actual->contexto_regs));
+	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema post_sem. Si hay procesos esperando
+ * despierta al primero, que se queda con la unidad; si no, incrementa
+ * el contador.
+ */
+int post_sem(){
+	semaforo *s;
+	int nivel_int;
+	BCP *proc;
+
+	s=objeto_de_descriptor((int)leer_registro(1), OBJ_SEM);
+	if (s==NULL)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((proc=s->esperando.primero)!=NULL) {
+		eliminar_primero(&s->esperando);
+		despertar(proc);
+	}
+	else
+		s->contador++;
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Cierra un descriptor de semaforo del proceso actual. Cuando ningun
+ * proceso lo tiene abierto el semaforo se destruye.
+ */
+int cerrar_sem_desc (unsigned int desc) {
+	semaforo *s;
+	int nivel_int;
+
+	s=objeto_de_descriptor(desc, OBJ_SEM);
+	if (s==NULL)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	liberar_descriptor(desc);
+	if (--s->abierto==0) {
+		borrar_nombre(&s->nombre);
+		s->sig_libre=sem_libre;
+		sem_libre=s-array_sem;
+	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+int cerrar_sem(){
+	return cerrar_sem_desc((unsigned int)leer_registro(1));
+}
+
+/*
+ *
+ * Rutinas de las variables condicion
+ *	iniciar_cond crear_cond abrir_cond cond_wait cond_signal
+ *	cond_broadcast cerrar_cond
+ *
+ * Igual que los semaforos, tienen nombre y usan los descriptores de cada
+ * proceso. cond_wait trabaja sobre un mutex que el proceso tiene cogido.
+ */
+
+/*
+ * Encadena todas las variables condicion en la lista de libres
+ */
+static void iniciar_cond(){
+	int i;
+
+	for (i=0; i<NUM_COND; i++)
+		array_cond[i].sig_libre=i+1;
+	array_cond[NUM_COND-1].sig_libre=-1;
+	cond_libre=0;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_cond. Devuelve un descriptor de
+ * una variable condicion nueva con ese nombre, o -1 si el nombre no es
+ * valido o ya existe, o no quedan descriptores o variables.
+ */
+int crear_cond(){
+	char *nombre;
+	int desc, c, nivel_int;
+
+	nombre=(char *)leer_registro(1);
+	if (strlen(nombre)>MAX_NOM_MUT)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((buscar_nombre(nombre)!=NULL) || ((desc=descriptor_libre())==-1) ||
+		(cond_libre==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	c=cond_libre;
+	cond_libre=array_cond[c].sig_libre;
+	registrar_nombre(&array_cond[c].nombre, nombre, OBJ_COND, &array_cond[c]);
+	array_cond[c].abierto=1;
+
+	ocupar_descriptor(desc, OBJ_COND, &array_cond[c]);
+	fijar_nivel_int(nivel_int);
+
+	printk("-> PROC %d: CREA CONDICION %s\n", p_proc_actual->id, nombre);
+	return desc;
+}
+
+/*
+ * Tratamiento de llamada al sistema abrir_cond. Devuelve un descriptor
+ * de la variable condicion con ese nombre, o -1.
+ */
+int abrir_cond(){
+	char *nombre;
+	int desc, nivel_int;
+	nombre_obj *ent;
+
+	nombre=(char *)leer_registro(1);
+	if (strlen(nombre)>MAX_NOM_MUT)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	ent=buscar_nombre(nombre);
+	if ((ent==NULL) || (ent->tipo!=OBJ_COND) ||
+		((desc=descriptor_libre())==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	ocupar_descriptor(desc, OBJ_COND, ent->objeto);
+	((condicion *)ent->objeto)->abierto++;
+	fijar_nivel_int(nivel_int);
+	return desc;
+}
+
+/*
+ * Tratamiento de llamada al sistema cond_wait. El proceso debe tener
+ * cogido el mutex. Con el reloj inhibido lo suelta (por completo si es
+ * recursivo), pasandoselo al primero que espera por el, y se bloquea en
+ * la variable, de modo que ningun aviso se pierde entre ambos pasos. Al
+ * despertar vuelve a coger el mutex con la misma cuenta que tenia.
+ */
+int cond_wait(){
+	int cuenta, nivel_int;
+	condicion *c;
+	mutex *m;
+	BCP *p_proc_bloq;
+
+	c=objeto_de_descriptor((int)leer_registro(1), OBJ_COND);
+	m=objeto_de_descriptor((int)leer_registro(2), OBJ_MUTEX);
+	if ((c==NULL) || (m==NULL) || (m->locked==0) ||
+		(m->propietario!=p_proc_actual->id))
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	cuenta=m->locked;
+	traspasar_mutex(m);
+	actualizar_prioridad(p_proc_actual);
+
+	p_proc_actual->estado=BLOQUEADO;
+	insertar_ultimo(&c->esperando, p_proc_actual);
+	p_proc_bloq=p_proc_actual;
 	p_proc_actual=planificador();
-	cambio_contexto(&(p_proc_dormido->contexto_regs), &(p_proc_actual->contexto_regs));
+	cambio_contexto(&(p_proc_bloq->contexto_regs),
+			&(p_proc_actual->contexto_regs));
+
+	/* avisado: espera por el mutex como en lock, que se lo traspasa */
+	if (m->locked>0)
+		esperar_mutex(m, SIN_PLAZO);
+	else
+		anotar_adquisicion(m);
+	m->locked=cuenta;
+	m->propietario=p_proc_actual->id;
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema cond_signal. Despierta al primer
+ * proceso que espera en la variable, si lo hay.
+ */
+int cond_signal(){
+	condicion *c;
+	int nivel_int;
+	BCP *proc;
+
+	c=objeto_de_descriptor((int)leer_registro(1), OBJ_COND);
+	if (c==NULL)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((proc=c->esperando.primero)!=NULL) {
+		eliminar_primero(&c->esperando);
+		despertar(proc);
+	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema cond_broadcast. Despierta a todos los
+ * procesos que esperan en la variable.
+ */
+int cond_broadcast(){
+	condicion *c;
+
+	c=objeto_de_descriptor((int)leer_registro(1), OBJ_COND);
+	if (c==NULL)
+		return -1;
+
+	despertar_todos(&c->esperando);
+	return 0;
+}
+
+/*
+ * Cierra un descriptor de variable condicion del proceso actual. Cuando
+ * ningun proceso la tiene abierta la variable se destruye.
+ */
+int cerrar_cond_desc (unsigned int desc) {
+	condicion *c;
+	int nivel_int;
+
+	c=objeto_de_descriptor(desc, OBJ_COND);
+	if (c==NULL)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	liberar_descriptor(desc);
+	if (--c->abierto==0) {
+		borrar_nombre(&c->nombre);
+		c->sig_libre=cond_libre;
+		cond_libre=c-array_cond;
+	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+int cerrar_cond(){
+	return cerrar_cond_desc((unsigned int)leer_registro(1));
+}
+
+/*
+ *
+ * Rutinas de los cerrojos de lectores y escritores
+ *	iniciar_rw crear_rw abrir_rw lock_lectura lock_escritura unlock_rw
+ *	cerrar_rw
+ *
+ * Preferencia para escritores: un lector nuevo espera si hay un escritor
+ * dentro o esperando. Al liberar se pasa el cerrojo directamente a quien
+ * se despierta (el primer escritor o todos los lectores en espera), que
+ * no tiene que volver a comprobar nada.
+ */
+
+/*
+ * Encadena todos los cerrojos en la lista de libres
+ */
+static void iniciar_rw(){
+	int i;
+
+	for (i=0; i<NUM_RW; i++)
+		array_rw[i].sig_libre=i+1;
+	array_rw[NUM_RW-1].sig_libre=-1;
+	rw_libre=0;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_rw. Devuelve un descriptor de un
+ * cerrojo nuevo con ese nombre, o -1 si el nombre no es valido o ya
+ * existe, o no quedan descriptores o cerrojos.
+ */
+int crear_rw(){
+	char *nombre;
+	int desc, r, nivel_int;
+
+	nombre=(char *)leer_registro(1);
+	if (strlen(nombre)>MAX_NOM_MUT)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((buscar_nombre(nombre)!=NULL) || ((desc=descriptor_libre())==-1) ||
+		(rw_libre==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	r=rw_libre;
+	rw_libre=array_rw[r].sig_libre;
+	registrar_nombre(&array_rw[r].nombre, nombre, OBJ_RW, &array_rw[r]);
+	array_rw[r].abierto=1;
+	array_rw[r].lectores=0;
+	array_rw[r].escritor=-1;
+
+	ocupar_descriptor(desc, OBJ_RW, &array_rw[r]);
+	fijar_nivel_int(nivel_int);
+
+	printk("-> PROC %d: CREA CERROJO RW %s\n", p_proc_actual->id, nombre);
+	return desc;
+}
+
+/*
+ * Tratamiento de llamada al sistema abrir_rw. Devuelve un descriptor del
+ * cerrojo con ese nombre, o -1.
+ */
+int abrir_rw(){
+	char *nombre;
+	int desc, nivel_int;
+	nombre_obj *ent;
+
+	nombre=(char *)leer_registro(1);
+	if (strlen(nombre)>MAX_NOM_MUT)
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	ent=buscar_nombre(nombre);
+	if ((ent==NULL) || (ent->tipo!=OBJ_RW) ||
+		((desc=descriptor_libre())==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+
+	ocupar_descriptor(desc, OBJ_RW, ent->objeto);
+	((cerrojo_rw *)ent->objeto)->abierto++;
+	fijar_nivel_int(nivel_int);
+	return desc;
+}
+
+/*
+ * Bloquea al proceso actual en una de las colas del cerrojo. Se llama con
+ * el reloj inhibido; al volver ya tiene el cerrojo.
+ */
+static void esperar_rw(lista_BCPs *cola){
+	BCP *p_proc_bloq;
 
+	p_proc_actual->estado=BLOQUEADO;
+	insertar_ultimo(cola, p_proc_actual);
+	p_proc_bloq=p_proc_actual;
+	p_proc_actual=planificador();
+	cambio_contexto(&(p_proc_bloq->contexto_regs),
+			&(p_proc_actual->contexto_regs));
+}
+
+/*
+ * Tratamiento de llamada al sistema lock_lectura
+ */
+int lock_lectura(){
+	int desc, nivel_int;
+	cerrojo_rw *r;
+
+	desc=(int)leer_registro(1);
+	r=objeto_de_descriptor(desc, OBJ_RW);
+	if ((r==NULL) || (p_proc_actual->descriptores[desc].uso!=RW_LIBRE))
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((r->escritor!=-1) ||
+		(r->escritores_esperando.primero!=NULL))
+		esperar_rw(&r->lectores_esperando);
+	else
+		r->lectores++;
+	p_proc_actual->descriptores[desc].uso=RW_LECTOR;
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema lock_escritura
+ */
+int lock_escritura(){
+	int desc, nivel_int;
+	cerrojo_rw *r;
+
+	desc=(int)leer_registro(1);
+	r=objeto_de_descriptor(desc, OBJ_RW);
+	if ((r==NULL) || (p_proc_actual->descriptores[desc].uso!=RW_LIBRE))
+		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((r->escritor!=-1) || (r->lectores>0))
+		esperar_rw(&r->escritores_esperando);
+	else
+		r->escritor=p_proc_actual->id;
+	p_proc_actual->descriptores[desc].uso=RW_ESCRITOR;
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
+
+/*
+ * Suelta el cerrojo que el proceso actual tiene cogido por el descriptor
+ * desc y se lo pasa a quien corresponda. Devuelve -1 si no lo tenia.
+ */
+static int soltar_rw(int desc, cerrojo_rw *r){
+	int nivel_int;
+	BCP *proc;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (p_proc_actual->descriptores[desc].uso==RW_ESCRITOR)
+		r->escritor=-1;
+	else if (p_proc_actual->descriptores[desc].uso==RW_LECTOR)
+		r->lectores--;
+	else {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+	p_proc_actual->descriptores[desc].uso=RW_LIBRE;
+
+	if (r->lectores==0 &&
+		(proc=r->escritores_esperando.primero)!=NULL) {
+		eliminar_primero(&r->escritores_esperando);
+		r->escritor=proc->id;
+		despertar(proc);
+	}
+	else if ((r->escritor==-1) &&
+		(r->escritores_esperando.primero==NULL))
+		while ((proc=r->lectores_esperando.primero)!=NULL) {
+			eliminar_primero(&r->lectores_esperando);
+			r->lectores++;
+			despertar(proc);
+		}
+	fijar_nivel_int(nivel_int);
 	return 0;
 }
 
-///////////////////////////
-///////////////////////////
-///////////////////////////
-int descriptor_libre () {
-	
-	int aux = -1;
-	int i = 0;
-
-	while((aux == -1) && (i <= NUM_MUT_PROC)) {
-		//Si descriptor = -1, no ha sido utilizado
-		if(p_proc_actual->descriptores[i] == -1) {
-			aux = i;
-		}
-		
-		i++;
-	}
+/*
+ * Tratamiento de llamada al sistema unlock_rw. Sirve para los dos modos.
+ */
+int unlock_rw(){
+	int desc;
+	cerrojo_rw *r;
 
-	return aux;		
+	desc=(int)leer_registro(1);
+	if ((r=objeto_de_descriptor(desc, OBJ_RW))==NULL)
+		return -1;
+	return soltar_rw(desc, r);
 }
 
-int crear_mutex (char *nombre, int tipo){
-	printk("Creando mutex\n");
-	nombre=(char *)leer_registro(1);
-	tipo=(int)leer_registro(2);
+/*
+ * Cierra un descriptor de cerrojo del proceso actual, soltandolo antes si
+ * lo tenia cogido. Cuando ningun proceso lo tiene abierto se destruye.
+ */
+int cerrar_rw_desc (unsigned int desc) {
+	cerrojo_rw *r;
+	int nivel_int;
 
-	if(strlen(nombre) > MAX_NOM_MUT){
+	r=objeto_de_descriptor(desc, OBJ_RW);
+	if (r==NULL)
 		return -1;
-	}
 
-	
-	int i;
-	for (i = 0; i < NUM_MUT; i++){
-		if(array_mutex[i].nombre != NULL && 
-			strcmp(array_mutex[i].nombre, nombre) == 0){
-			return -1;
-		}
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	soltar_rw(desc, r);
+	liberar_descriptor(desc);
+	if (--r->abierto==0) {
+		borrar_nombre(&r->nombre);
+		r->sig_libre=rw_libre;
+		rw_libre=r-array_rw;
 	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
 
-	int descriptor_proc = descriptor_libre();
-	if(descriptor_proc == -1) {
-		printk("El proceso no tiene descriptores libres\n");
-		return -1; 
-	}
+int cerrar_rw(){
+	return cerrar_rw_desc((unsigned int)leer_registro(1));
+}
 
-	
-	while(mutex_creados==NUM_MUT) {
+/*
+ *
+ * Rutinas de las barreras
+ *	iniciar_barreras crear_barrera abrir_barrera esperar_barrera
+ *	cerrar_barrera
+ *
+ */
 
-		int nivel_int = fijar_nivel_int(NIVEL_3);
+/*
+ * Encadena todas las barreras en la lista de libres
+ */
+static void iniciar_barreras(){
+	int i;
 
-		p_proc_actual->estado=BLOQUEADO;
+	for (i=0; i<NUM_BARRERAS; i++)
+		array_barreras[i].sig_libre=i+1;
+	array_barreras[NUM_BARRERAS-1].sig_libre=-1;
+	barrera_libre=0;
+}
 
-		eliminar_primero(&lista_listos);
-		insertar_ultimo(&lista_bloq_mutex, p_proc_actual);
+/*
+ * Tratamiento de llamada al sistema crear_barrera. Devuelve un descriptor
+ * de una barrera nueva para n procesos, o -1 si el nombre o n no son
+ * validos, o no quedan descriptores o barreras.
+ */
+int crear_barrera(){
+	char *nombre;
+	int n, desc, b, nivel_int;
 
-		BCP* p_proc_bloq = p_proc_actual;
-		p_proc_actual=planificador();
+	nombre=(char *)leer_registro(1);
+	n=(int)leer_registro(2);
+	if ((strlen(nombre)>MAX_NOM_MUT) || (n<1))
+		return -1;
 
-		cambio_contexto(&(p_proc_bloq->contexto_regs), &(p_proc_actual->contexto_regs));
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((buscar_nombre(nombre)!=NULL) || ((desc=descriptor_libre())==-1) ||
+		(barrera_libre==-1)) {
 		fijar_nivel_int(nivel_int);
+		return -1;
 	}
-	
 
-	int descriptor_mut = descriptor_mutex();
+	b=barrera_libre;
+	barrera_libre=array_barreras[b].sig_libre;
+	registrar_nombre(&array_barreras[b].nombre, nombre, OBJ_BARRERA,
+			&array_barreras[b]);
+	array_barreras[b].abierto=1;
+	array_barreras[b].n=n;
+	array_barreras[b].llegados=0;
 
+	ocupar_descriptor(desc, OBJ_BARRERA, &array_barreras[b]);
+	fijar_nivel_int(nivel_int);
 
-	p_proc_actual->descriptores[descriptor_proc] = descriptor_mut;
-
-	array_mutex[descriptor_mut].nombre = nombre;
-	array_mutex[descriptor_mut].tipo = tipo;
-	array_mutex[descriptor_mut].abierto++;
-	mutex_creados++;
-	p_proc_actual->n_descriptores++;
-
-	printk("Mutex creado correctamente\n");
-	return descriptor_proc; 
+	printk("-> PROC %d: CREA BARRERA %s (%d)\n", p_proc_actual->id,
+		nombre, n);
+	return desc;
 }
 
+/*
+ * Tratamiento de llamada al sistema abrir_barrera. Devuelve un descriptor
+ * de la barrera con ese nombre, o -1.
+ */
+int abrir_barrera(){
+	char *nombre;
+	int desc, nivel_int;
+	nombre_obj *ent;
 
-
-int abrir_mutex(char *nombre) {
-	printk("Abriendo mutex\n");
 	nombre=(char *)leer_registro(1);
-
-	if(strlen(nombre) > MAX_NOM_MUT){
+	if (strlen(nombre)>MAX_NOM_MUT)
 		return -1;
-	}
-
-	
 
-	if((nombres_iguales(nombre)) == 0) {
-		printk("No se ha encontrado un mutex con este nombre\n");
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	ent=buscar_nombre(nombre);
+	if ((ent==NULL) || (ent->tipo!=OBJ_BARRERA) ||
+		((desc=descriptor_libre())==-1)) {
+		fijar_nivel_int(nivel_int);
 		return -1;
 	}
 
-	int descriptor_proc = descriptor_libre();
-	if(descriptor_proc == -1) {
-		printk("El proceso no tiene descriptores libres\n");
-		return -1; 
-	}
-
-	
-	int descriptor_mut;
-	for(int i=0; i<mutex_creados; i++) {
-		if(strcmp(array_mutex[i].nombre, nombre) == 0) {
-			descriptor_mut = i;
-		}
-	}
+	ocupar_descriptor(desc, OBJ_BARRERA, ent->objeto);
+	((barrera *)ent->objeto)->abierto++;
+	fijar_nivel_int(nivel_int);
+	return desc;
+}
 
+/*
+ * Tratamiento de llamada al sistema esperar_barrera. Los n-1 primeros en
+ * llegar se bloquean; el ultimo los pasa a todos a listos de una vez y
+ * sigue ejecutando. Devuelve 1 al ultimo y 0 a los demas.
+ */
+int esperar_barrera(){
+	barrera *b;
+	int nivel_int;
+	BCP *p_proc_bloq;
 
-	p_proc_actual->descriptores[descriptor_proc]=descriptor_mut;
-	p_proc_actual->n_descriptores++;
+	b=objeto_de_descriptor((int)leer_registro(1), OBJ_BARRERA);
+	if (b==NULL)
+		return -1;
 
-	array_mutex[descriptor_mut].abierto++;
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if (++b->llegados==b->n) {
+		b->llegados=0;
+		despertar_todos(&b->esperando);
+		fijar_nivel_int(nivel_int);
+		return 1;
+	}
 
-	printk("Mutex abierto correctamente\n");
-	return descriptor_proc; 
+	p_proc_actual->estado=BLOQUEADO;
+	insertar_ultimo(&b->esperando, p_proc_actual);
+	p_proc_bloq=p_proc_actual;
+	p_proc_actual=planificador();
+	cambio_contexto(&(p_proc_bloq->contexto_regs),
+			&(p_proc_actual->contexto_regs));
+	fijar_nivel_int(nivel_int);
+	return 0;
 }
 
+/*
+ * Cierra un descriptor de barrera del proceso actual. Cuando ningun
+ * proceso la tiene abierta la barrera se destruye.
+ */
+int cerrar_barrera_desc (unsigned int desc) {
+	barrera *b;
+	int nivel_int;
 
-
-
-int lock (unsigned int mutexid) {
-	printk("Haciendo lock\n");
-	int desc_proc=(unsigned int)leer_registro(1); 
-	mutexid = p_proc_actual->descriptores[desc_proc];
-	int proceso_esperando = 1; 
-
-	if(mutexid == -1) {
-		printk("El mutex no existe \n");
+	b=objeto_de_descriptor(desc, OBJ_BARRERA);
+	if (b==NULL)
 		return -1;
+
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	liberar_descriptor(desc);
+	if (--b->abierto==0) {
+		borrar_nombre(&b->nombre);
+		b->sig_libre=barrera_libre;
+		barrera_libre=b-array_barreras;
 	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
 
-	while (proceso_esperando) {
+int cerrar_barrera(){
+	return cerrar_barrera_desc((unsigned int)leer_registro(1));
+}
 
-		
-		if(array_mutex[mutexid].locked > 0) {
-			if((array_mutex[mutexid].tipo) == RECURSIVO) {
-				if(array_mutex[mutexid].propietario == p_proc_actual->id) {
-					
-					array_mutex[mutexid].locked++;
-					proceso_esperando = 0;
-				}
-				
-				else {
-					int nivel_int = fijar_nivel_int(NIVEL_3);
-
-					
-					p_proc_actual->estado=BLOQUEADO;
-					
-					eliminar_primero(&lista_listos);
-					insertar_ultimo(&(array_mutex[mutexid].lista_proc_esperando_lock), p_proc_actual);
-					
-					
-					BCP* p_proc_bloq = p_proc_actual; 
-					p_proc_actual=planificador();
-					
-					
-					cambio_contexto(&(p_proc_bloq->contexto_regs), &(p_proc_actual->contexto_regs));
-
-					
-					fijar_nivel_int(nivel_int);
-				} 
+/*
+ *
+ * Rutinas de las colas de mensajes
+ *	iniciar_colas reservar_mensaje liberar_mensaje crear_cola
+ *	abrir_cola enviar recibir cerrar_cola
+ *
+ */
 
-			} 
-			
-			else {
-				
-				if(array_mutex[mutexid].propietario == p_proc_actual->id) {				
-					return -1;
-				}
-				
-				else {
-					
-					int nivel_int = fijar_nivel_int(NIVEL_3);
-
-					
-					p_proc_actual->estado=BLOQUEADO;
-					
-					eliminar_primero(&lista_listos);
-					insertar_ultimo(&(array_mutex[mutexid].lista_proc_esperando_lock), p_proc_actual);
-					
-					
-					BCP* p_proc_bloq = p_proc_actual; 
-					p_proc_actual=planificador();
-					cambio_contexto(&(p_proc_bloq->contexto_regs), &(p_proc_actual->contexto_regs));
-
-					
-					fijar_nivel_int(nivel_int);
-				} 
-			}
-		} 
-		
-		else {
-			array_mutex[mutexid].locked++;
-			proceso_esperando = 0;
-		} 
-	} 
+/*
+ * Encadena todas las colas en la lista de libres
+ */
+static void iniciar_colas(){
+	int i;
 
-	array_mutex[mutexid].propietario = p_proc_actual->id;
-	printk("Lock realizado sobre mutex\n");
-	return 0;
+	for (i=0; i<NUM_COLAS; i++)
+		array_colas[i].sig_libre=i+1;
+	array_colas[NUM_COLAS-1].sig_libre=-1;
+	cola_libre=0;
 }
 
+/*
+ * Mete un mensaje en la lista de los de un proceso
+ */
+static void dar_mensaje(mensaje *m, BCP *proc){
+	m->propietario=proc->id;
+	m->ant=NULL;
+	m->sig=proc->mensajes;
+	if (m->sig)
+		m->sig->ant=m;
+	proc->mensajes=m;
+}
 
-int unlock (unsigned int mutexid) {
+/*
+ * Saca un mensaje de la lista del proceso actual
+ */
+static void quitar_mensaje(mensaje *m){
+	if (m->ant)
+		m->ant->sig=m->sig;
+	else
+		p_proc_actual->mensajes=m->sig;
+	if (m->sig)
+		m->sig->ant=m->ant;
+	m->propietario=-1;
+}
 
-	int desc_proc=(unsigned int)leer_registro(1); 
-	mutexid = p_proc_actual->descriptores[desc_proc];
+/*
+ * Devuelve el mensaje al que pertenece un buffer de datos, o NULL si no
+ * es del proceso actual. Se busca en su lista, sin fiarse del puntero
+ * del usuario, que puede ser de un mensaje ya enviado o liberado.
+ */
+static mensaje * mensaje_de_buffer(void *buf){
+	mensaje *m;
 
-	
-	if(array_mutex[mutexid].abierto == 0) {
-		return -1;
-	}
+	for (m=p_proc_actual->mensajes; m; m=m->sig)
+		if (m->datos==buf)
+			return m;
+	return NULL;
+}
 
-	
-	if(array_mutex[mutexid].locked > 0) {
-		
-		if((array_mutex[mutexid].tipo) == RECURSIVO) {
-			if(array_mutex[mutexid].propietario == p_proc_actual->id) {
+/*
+ * Pone un mensaje al final de una cola
+ */
+static void encolar_mensaje(cola_msj *c, mensaje *m){
+	m->propietario=-1;
+	m->sig=NULL;
+	if (c->ultimo)
+		c->ultimo->sig=m;
+	else
+		c->primero=m;
+	c->ultimo=m;
+	c->n_mensajes++;
+}
 
-				array_mutex[mutexid].locked--;
+/*
+ * Saca el primer mensaje de una cola, o devuelve NULL si esta vacia
+ */
+static mensaje * desencolar_mensaje(cola_msj *c){
+	mensaje *m=c->primero;
+
+	if (m==NULL)
+		return NULL;
+	c->primero=m->sig;
+	if (c->primero==NULL)
+		c->ultimo=NULL;
+	c->n_mensajes--;
+	return m;
+}
 
-				if(array_mutex[mutexid].locked == 0) {
-					if(((array_mutex[mutexid].lista_proc_esperando_lock).primero) != NULL) {
+/*
+ * Libera los mensajes que todavia son del proceso actual, y el que
+ * entregaba o recibia si lo hay. Se llama al terminar de cualquier forma,
+ * despues de cerrar sus colas.
+ */
+static void liberar_mensajes_proceso(){
+	mensaje *m;
 
-						int nivel_int = fijar_nivel_int(NIVEL_3);
-						BCP* proc_esperando = (array_mutex[mutexid].lista_proc_esperando_lock).primero;
-						proc_esperando->estado = LISTO;
-						eliminar_primero(&(array_mutex[mutexid].lista_proc_esperando_lock)); 
-						insertar_ultimo(&lista_listos, proc_esperando);
-						fijar_nivel_int(nivel_int);
-					} 
+	while ((m=p_proc_actual->mensajes)!=NULL) {
+		p_proc_actual->mensajes=m->sig;
+		free(m);
+	}
+	free(p_proc_actual->msj_pendiente);
+	p_proc_actual->msj_pendiente=NULL;
+}
 
-					array_mutex[mutexid].propietario = -1;
-				} 
-			} 
-			else {
-				return -1;
-			} 
-		} 
-		else {
-			
-			if(array_mutex[mutexid].propietario == p_proc_actual->id) {
-	
-				array_mutex[mutexid].locked--;
-				array_mutex[mutexid].propietario = -1;
+/*
+ * Tratamiento de llamada al sistema reservar_mensaje. Reserva un buffer
+ * del nucleo para un mensaje de la longitud indicada, que pasa a ser del
+ * proceso, y deja en *buf la direccion de sus datos. Devuelve -1 si la
+ * longitud no es valida o no hay memoria.
+ */
+int reservar_mensaje(){
+	unsigned int longitud;
+	void **buf;
+	mensaje *m;
+	int nivel_int;
+
+	longitud=(unsigned int)leer_registro(1);
+	buf=(void **)leer_registro(2);
+	if ((longitud==0) || (longitud>MAX_TAM_MENSAJE) || (buf==NULL))
+		return -1;
+	if ((m=malloc(sizeof(mensaje)+longitud))==NULL)
+		return -1;
 
-				if(((array_mutex[mutexid].lista_proc_esperando_lock).primero) != NULL) {
-					int nivel_int = fijar_nivel_int(NIVEL_3);
+	m->longitud=longitud;
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	dar_mensaje(m, p_proc_actual);
+	fijar_nivel_int(nivel_int);
+	*buf=m->datos;
+	return 0;
+}
 
-					BCP* proc_esperando = (array_mutex[mutexid].lista_proc_esperando_lock).primero;
-					proc_esperando->estado = LISTO;
-					eliminar_primero(&(array_mutex[mutexid].lista_proc_esperando_lock)); 
-					insertar_ultimo(&lista_listos, proc_esperando);
+/*
+ * Tratamiento de llamada al sistema liberar_mensaje. Devuelve al nucleo
+ * un buffer de mensaje del proceso.
+ */
+int liberar_mensaje(){
+	mensaje *m;
+	int nivel_int;
 
-					fijar_nivel_int(nivel_int);
-					
-				} 
-			} 
-			else {
-				return -1;
-			}
-		} 
-	} 
-	
-	else {
+	if ((m=mensaje_de_buffer((void *)leer_registro(1)))==NULL)
 		return -1;
-	}
 
-	printk("Unlock realizado correctamente\n");
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	quitar_mensaje(m);
+	fijar_nivel_int(nivel_int);
+	free(m);
 	return 0;
 }
 
+/*
+ * Tratamiento de llamada al sistema crear_cola. Devuelve un descriptor de
+ * una cola nueva en la que caben capacidad mensajes, o -1 si el nombre o
+ * la capacidad no son validos, o no quedan descriptores o colas.
+ */
+int crear_cola(){
+	char *nombre;
+	int capacidad, desc, c, nivel_int;
 
-int cerrar_mutex (unsigned int mutexid) {
-
-	unsigned int registro=(unsigned int)leer_registro(1);
-	if(registro < 16) {
-		mutexid = registro;
-	}
-	
-	int desc_mut = p_proc_actual->descriptores[mutexid];
+	nombre=(char *)leer_registro(1);
+	capacidad=(int)leer_registro(2);
+	if ((strlen(nombre)>MAX_NOM_MUT) || (capacidad<1) ||
+		(capacidad>MAX_CAPACIDAD_COLA))
+		return -1;
 
-	if(array_mutex[desc_mut].nombre == NULL) {
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((buscar_nombre(nombre)!=NULL) || ((desc=descriptor_libre())==-1) ||
+		(cola_libre==-1)) {
+		fijar_nivel_int(nivel_int);
 		return -1;
 	}
 
-	
-	p_proc_actual->descriptores[mutexid] = -1;
-	p_proc_actual->n_descriptores--;
+	c=cola_libre;
+	cola_libre=array_colas[c].sig_libre;
+	registrar_nombre(&array_colas[c].nombre, nombre, OBJ_COLA,
+			&array_colas[c]);
+	array_colas[c].abierto=1;
+	array_colas[c].capacidad=capacidad;
+	array_colas[c].n_mensajes=0;
+	array_colas[c].primero=NULL;
+	array_colas[c].ultimo=NULL;
+
+	ocupar_descriptor(desc, OBJ_COLA, &array_colas[c]);
+	fijar_nivel_int(nivel_int);
 
-	
-	if(array_mutex[desc_mut].propietario == p_proc_actual->id) {
-		
-		array_mutex[desc_mut].locked = 0;
+	printk("-> PROC %d: CREA COLA %s (%d)\n", p_proc_actual->id,
+		nombre, capacidad);
+	return desc;
+}
 
-		while((array_mutex[desc_mut].lista_proc_esperando_lock).primero != NULL) {
+/*
+ * Tratamiento de llamada al sistema abrir_cola. Devuelve un descriptor
+ * de la cola con ese nombre, o -1.
+ */
+int abrir_cola(){
+	char *nombre;
+	int desc, nivel_int;
+	nombre_obj *ent;
 
-			int nivel_int = fijar_nivel_int(NIVEL_3);
+	nombre=(char *)leer_registro(1);
+	if (strlen(nombre)>MAX_NOM_MUT)
+		return -1;
 
-			BCP* proc_esperando = (array_mutex[desc_mut].lista_proc_esperando_lock).primero;
-			proc_esperando->estado = LISTO;
-			eliminar_primero(&(array_mutex[desc_mut].lista_proc_esperando_lock)); 
-			insertar_ultimo(&lista_listos, proc_esperando);
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	ent=buscar_nombre(nombre);
+	if ((ent==NULL) || (ent->tipo!=OBJ_COLA) ||
+		((desc=descriptor_libre())==-1)) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
 
-			fijar_nivel_int(nivel_int);
+	ocupar_descriptor(desc, OBJ_COLA, ent->objeto);
+	((cola_msj *)ent->objeto)->abierto++;
+	fijar_nivel_int(nivel_int);
+	return desc;
+}
 
-		}
-	
-	}
-	array_mutex[desc_mut].abierto--;
+/*
+ * Tratamiento de llamada al sistema enviar. El mensaje deja de ser del
+ * proceso: si hay un receptor esperando se le da directamente y si no se
+ * pone al final de la cola. Con la cola llena, en modo NO_BLOQUEANTE
+ * devuelve -1 y el mensaje sigue siendo del proceso; si no, este espera
+ * a que un receptor saque un mensaje y meta el suyo en el hueco.
+ */
+int enviar(){
+	cola_msj *c;
+	mensaje *m;
+	int modo, nivel_int;
+	BCP *proc, *p_proc_bloq;
+
+	c=objeto_de_descriptor((int)leer_registro(1), OBJ_COLA);
+	m=mensaje_de_buffer((void *)leer_registro(2));
+	modo=(int)leer_registro(3);
+	if ((c==NULL) || (m==NULL))
+		return -1;
 
-	
-	if(array_mutex[desc_mut].abierto <= 0) {
-		mutex_creados--;
-		while(lista_bloq_mutex.primero != NULL) {
-			int nivel_int = fijar_nivel_int(NIVEL_3);
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((proc=c->receptores.primero)!=NULL) {
+		quitar_mensaje(m);
+		eliminar_primero(&c->receptores);
+		dar_mensaje(m, proc);
+		proc->msj_pendiente=m;
+		despertar(proc);
+	}
+	else if (c->n_mensajes<c->capacidad) {
+		quitar_mensaje(m);
+		encolar_mensaje(c, m);
+	}
+	else if (modo==NO_BLOQUEANTE) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+	else {
+		quitar_mensaje(m);
+		p_proc_actual->msj_pendiente=m;
+		p_proc_actual->estado=BLOQUEADO;
+		insertar_ultimo(&c->emisores, p_proc_actual);
+		p_proc_bloq=p_proc_actual;
+		p_proc_actual=planificador();
+		cambio_contexto(&(p_proc_bloq->contexto_regs),
+				&(p_proc_actual->contexto_regs));
+	}
+	fijar_nivel_int(nivel_int);
+	return 0;
+}
 
-			BCP* proc_esperando = lista_bloq_mutex.primero;
-			proc_esperando->estado = LISTO;
-			eliminar_primero(&lista_bloq_mutex); 
-			insertar_ultimo(&lista_listos, proc_esperando);
+/*
+ * Tratamiento de llamada al sistema recibir. Saca el primer mensaje de la
+ * cola, que pasa a ser del proceso, deja en *buf la direccion de sus
+ * datos y devuelve su longitud. Si habia un emisor esperando mete su
+ * mensaje en el hueco. Con la cola vacia, en modo NO_BLOQUEANTE devuelve
+ * -1; si no, espera a que un emisor le de un mensaje.
+ */
+int recibir(){
+	cola_msj *c;
+	mensaje *m;
+	void **buf;
+	int modo, nivel_int;
+	BCP *proc, *p_proc_bloq;
+
+	c=objeto_de_descriptor((int)leer_registro(1), OBJ_COLA);
+	buf=(void **)leer_registro(2);
+	modo=(int)leer_registro(3);
+	if ((c==NULL) || (buf==NULL))
+		return -1;
 
-			fijar_nivel_int(nivel_int);
-			printk("Se ha desbloqueado el proceso\n");
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	if ((m=desencolar_mensaje(c))!=NULL) {
+		dar_mensaje(m, p_proc_actual);
+		if ((proc=c->emisores.primero)!=NULL) {
+			eliminar_primero(&c->emisores);
+			encolar_mensaje(c, proc->msj_pendiente);
+			proc->msj_pendiente=NULL;
+			despertar(proc);
 		}
 	}
+	else if (modo==NO_BLOQUEANTE) {
+		fijar_nivel_int(nivel_int);
+		return -1;
+	}
+	else {
+		/* enviar le da el mensaje directamente al despertarlo */
+		p_proc_actual->estado=BLOQUEADO;
+		insertar_ultimo(&c->receptores, p_proc_actual);
+		p_proc_bloq=p_proc_actual;
+		p_proc_actual=planificador();
+		cambio_contexto(&(p_proc_bloq->contexto_regs),
+				&(p_proc_actual->contexto_regs));
+		m=p_proc_actual->msj_pendiente;
+		p_proc_actual->msj_pendiente=NULL;
+	}
+	fijar_nivel_int(nivel_int);
+	*buf=m->datos;
+	return m->longitud;
+}
 
+/*
+ * Cierra un descriptor de cola del proceso actual. Cuando ningun proceso
+ * la tiene abierta la cola se destruye con los mensajes que queden.
+ */
+int cerrar_cola_desc (unsigned int desc) {
+	cola_msj *c;
+	mensaje *m;
+	int nivel_int;
 
+	c=objeto_de_descriptor(desc, OBJ_COLA);
+	if (c==NULL)
+		return -1;
 
+	nivel_int=fijar_nivel_int(NIVEL_3);
+	liberar_descriptor(desc);
+	if (--c->abierto==0) {
+		while ((m=desencolar_mensaje(c))!=NULL)
+			free(m);
+		borrar_nombre(&c->nombre);
+		c->sig_libre=cola_libre;
+		cola_libre=c-array_colas;
+	}
+	fijar_nivel_int(nivel_int);
 	return 0;
 }
+
+int cerrar_cola(){
+	return cerrar_cola_desc((unsigned int)leer_registro(1));
+}
 /*
  *
  * Rutina de inicializaci�n invocada en arranque
@@ -758,6 +3718,13 @@ int main(){
 	iniciar_cont_teclado();		/* inici cont. teclado */
 
 	iniciar_tabla_proc();		/* inicia BCPs de tabla de procesos */
+	iniciar_planificador();		/* elige la politica de planificacion */
+	iniciar_grupos();		/* crea el grupo inicial */
+	iniciar_sem();			/* y todos los semaforos */
+	iniciar_cond();			/* y las variables condicion */
+	iniciar_rw();			/* y los cerrojos de lectura/escritura */
+	iniciar_barreras();		/* y las barreras */
+	iniciar_colas();		/* y las colas de mensajes */
 
 	/* crea proceso inicial */
 	if (crear_tarea((void *)"init")<0)
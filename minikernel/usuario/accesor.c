@@ -0,0 +1,55 @@
+/*
+ * usuario/accesor.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que entra tres veces en el cerrojo tabla, como
+ * escritor si su identificador es multiplo de 3 y como lector si no. Los
+ * lectores pueden coincidir entre ellos pero nunca con un escritor.
+ */
+
+#include "servicios.h"
+
+/* variables compartidas por todos los procesos de este programa */
+int lectores=0;
+int escritores=0;
+
+int main(){
+	int i, id, desc, escribe;
+
+	id=obtener_id_pr();
+	escribe=(id%3==0);
+	if ((desc=abrir_rw("tabla"))<0) {
+		printf("accesor (%d): error abriendo tabla\n", id);
+		return -1;
+	}
+
+	for (i=0; i<3; i++) {
+		if (escribe) {
+			lock_escritura(desc);
+			escritores++;
+			printf("accesor (%d): escribe con %d lectores y %d escritores\n",
+				id, lectores, escritores);
+			if ((lectores>0) || (escritores>1))
+				printf("accesor (%d): escritura no exclusiva. NO DEBE SALIR\n", id);
+			dormir_ms(100);
+			escritores--;
+		}
+		else {
+			lock_lectura(desc);
+			lectores++;
+			printf("accesor (%d): lee con %d lectores\n", id, lectores);
+			if (escritores>0)
+				printf("accesor (%d): lectura con escritor. NO DEBE SALIR\n", id);
+			dormir_ms(100);
+			lectores--;
+		}
+		unlock_rw(desc);
+	}
+
+	printf("accesor (%d): termina\n", id);
+	return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * usuario/cedente.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que en cada iteracion cede la UCP al primer otro
+ * proceso listo que encuentra, y si no hay ninguno la cede sin destino.
+ * Dos cedente deben alternarse en cada iteracion.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 5
+#define MAX_PID 10	/* tamano de la tabla de procesos */
+
+int main(){
+	int i, pid, id;
+
+	id=obtener_id_pr();
+	for (i=0; i<TOT_ITER; i++) {
+		printf("cedente (%d): i %d\n", id, i);
+		for (pid=0; pid<MAX_PID; pid++)
+			if ((pid!=id) && (ceder_a(pid)==0))
+				break;
+		if (pid==MAX_PID)
+			ceder();
+	}
+	printf("cedente (%d): termina\n", id);
+	return 0;
+}
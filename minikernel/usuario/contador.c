@@ -0,0 +1,45 @@
+/*
+ * usuario/contador.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que incrementa un contador compartido con los
+ * demas procesos contador dentro de una seccion critica protegida por
+ * el cerrojo de usuario. La seccion es larga para que haya expulsiones
+ * dentro de ella. El ultimo en terminar debe ver TOT_ITER por proceso.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 50
+#define N_PROCS 3
+
+/* variables compartidas por todos los procesos de este programa */
+int cerrojo=0;
+int compartido=0;
+int terminados=0;
+
+int main(){
+	int i, j, valor, tot=0, id;
+
+	id=obtener_id_pr();
+	for (i=0; i<TOT_ITER; i++) {
+		futex_lock(&cerrojo);
+		valor=compartido;
+		for (j=0; j<1000000; j++)
+			tot+=j;
+		compartido=valor+1;
+		futex_unlock(&cerrojo);
+	}
+
+	futex_lock(&cerrojo);
+	if (++terminados==N_PROCS)
+		printf("contador (%d): total %d (debe ser %d)\n", id, compartido,
+			N_PROCS*TOT_ITER);
+	futex_unlock(&cerrojo);
+	tot--;
+	return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * usuario/contendiente.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que coge cinco veces el mutex me y lo retiene 100
+ * ms cada vez, de modo que los demas contendiente tienen que esperar.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, desc;
+
+	if ((desc=abrir_mutex("me"))<0) {
+		printf("contendiente: error abriendo me\n");
+		return -1;
+	}
+
+	for (i=0; i<5; i++) {
+		lock(desc);
+		dormir_ms(100);
+		unlock(desc);
+	}
+	return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * usuario/controlador.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que simula un lazo de control periodico de la
+ * clase de tiempo real. En cada periodo gasta algo de UCP y comprueba si
+ * ha terminado antes del plazo.
+ */
+
+#include "servicios.h"
+
+#define PERIODO 20	/* ticks */
+#define PRESUPUESTO 8
+#define TOT_ITER 10
+#define CARGA 8000000	/* iteraciones de trabajo por periodo */
+
+int main(){
+	int i, j, tot=0, id, incumplidos=0;
+	unsigned int siguiente;
+
+	id=obtener_id_pr();
+	if (fijar_tiempo_real(PERIODO, PRESUPUESTO, PERIODO)<0) {
+		printf("controlador (%d): reserva rechazada\n", id);
+		return 0;
+	}
+
+	/* empieza en el mismo tick que los repartidor para competir con ellos */
+	siguiente=TICKS_POR_SEG*((obtener_ticks()/TICKS_POR_SEG)+2);
+	dormir_hasta(siguiente);
+	for (i=0; i<TOT_ITER; i++) {
+		for (j=0; j<CARGA; j++)
+			tot+=j;
+		siguiente+=PERIODO;
+		if ((int)(obtener_ticks()-siguiente)>0)
+			incumplidos++;
+		dormir_hasta(siguiente);
+	}
+
+	printf("controlador (%d): %d plazos incumplidos de %d\n", id,
+		incumplidos, TOT_ITER);
+	tot--;
+	return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * usuario/emisor.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que envia mensajes grandes a la cola c1. A mitad
+ * duerme, para que prueba_colas se bloquee esperando en la cola vacia, y
+ * termina con un mensaje sin enviar, que libera el nucleo.
+ */
+
+#include "servicios.h"
+
+#define N_MENSAJES 10
+#define TAM_MENSAJE 65536
+
+/* cabecera que espera prueba_colas en cada mensaje */
+typedef struct {
+	void *buffer;	/* direccion en la que se relleno */
+	int n;
+} cabecera;
+
+int main(){
+	int i, desc;
+	void *buf;
+	cabecera *cab;
+
+	printf("emisor comienza\n");
+
+	if ((desc=abrir_cola("c1"))<0) {
+		printf("emisor: error abriendo c1\n");
+		return -1;
+	}
+
+	for (i=0; i<N_MENSAJES; i++) {
+		if (i==N_MENSAJES/2) {
+			printf("emisor duerme 1 segundo\n");
+			dormir(1);
+		}
+		if (reservar_mensaje(TAM_MENSAJE, &buf)<0) {
+			printf("emisor: error reservando mensaje\n");
+			return -1;
+		}
+		cab=buf;
+		cab->buffer=buf;
+		cab->n=i;
+		if (enviar(desc, buf, BLOQUEANTE)<0)
+			printf("emisor: error enviando %d. NO DEBE SALIR\n", i);
+	}
+
+	if (reservar_mensaje(TAM_MENSAJE, &buf)<0)
+		printf("emisor: error reservando mensaje\n");
+
+	printf("emisor termina\n");
+	return 0;
+}
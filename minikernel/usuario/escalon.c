@@ -0,0 +1,86 @@
+/*
+ * usuario/escalon.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario de la prueba de herencia de prioridad. El papel de
+ * cada proceso depende de su orden de llegada: bajo, medio, alto y
+ * ocupado. Todos preparan sus mutex y fijan su prioridad antes de que
+ * empiece la contencion, que se ordena con dormir_ms: medio espera por
+ * m1 (de bajo), ocupado se pone a calcular y por ultimo alto espera por
+ * m2 (de medio). Con herencia bajo pasa a tener la prioridad de alto,
+ * asi que debe soltar m1, y alto terminar, antes de que termine ocupado.
+ */
+
+#include "servicios.h"
+
+#define BAJO 0
+#define MEDIO 1
+#define ALTO 2
+#define OCUPADO 3
+
+/* variables compartidas por todos los procesos de este programa */
+int llegados=0;
+int soltado_m1=0;
+int alto_terminado=0;
+
+static int calcular(int n){
+	int i, tot=0;
+
+	for (i=0; i<n; i++)
+		tot+=i;
+	return tot;
+}
+
+int main(){
+	int m1, m2, papel;
+
+	papel=llegados++;
+	switch (papel) {
+	case BAJO:
+		m1=crear_mutex("m1", NO_RECURSIVO);
+		lock(m1);
+		fijar_prioridad(20);
+		/* empieza a calcular cuando ocupado ya no le deja */
+		dormir_ms(100);
+		calcular(300000000);
+		printf("escalon bajo: suelta m1\n");
+		soltado_m1=1;
+		unlock(m1);
+		printf("escalon bajo: termina\n");
+		break;
+	case MEDIO:
+		m2=crear_mutex("m2", NO_RECURSIVO);
+		lock(m2);
+		m1=abrir_mutex("m1");
+		fijar_prioridad(10);
+		dormir_ms(20);
+		lock(m1);
+		unlock(m1);
+		unlock(m2);
+		printf("escalon medio: termina\n");
+		break;
+	case ALTO:
+		m2=abrir_mutex("m2");
+		fijar_prioridad(PRIO_MAX);
+		dormir_ms(150);
+		lock(m2);
+		unlock(m2);
+		printf("escalon alto: termina\n");
+		alto_terminado=1;
+		break;
+	default:
+		fijar_prioridad(5);
+		dormir_ms(50);
+		calcular(300000000);
+		if (!soltado_m1)
+			printf("escalon ocupado: bajo no ha soltado m1. NO DEBE SALIR\n");
+		if (!alto_terminado)
+			printf("escalon ocupado: alto no ha terminado. NO DEBE SALIR\n");
+		printf("escalon ocupado: termina\n");
+	}
+	return 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * usuario/esperador.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que espera en la variable condicion cturno a que
+ * llegue su turno. Los turnos se dan en orden inverso al de llegada, asi
+ * que todos salvo el ultimo tienen que esperar.
+ */
+
+#include "servicios.h"
+
+#define N_PROCS 4
+
+/* variables compartidas por todos los procesos de este programa */
+int llegados=0;
+int turno=0;
+
+int main(){
+	int id, mut, cond, mio;
+
+	id=obtener_id_pr();
+	if (((mut=abrir_mutex("mturno"))<0) || ((cond=abrir_cond("cturno"))<0)) {
+		printf("esperador (%d): error abriendo los objetos\n", id);
+		return -1;
+	}
+
+	lock(mut);
+	mio=N_PROCS-1-llegados++;
+	while (turno!=mio)
+		cond_wait(cond, mut);
+	printf("esperador (%d): turno %d\n", id, mio);
+	turno++;
+	cond_broadcast(cond);
+	unlock(mut);
+
+	/* termina sin cerrar los descriptores: los cierra el nucleo */
+	return 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * usuario/etapa.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que hace tres fases de calculo de distinta duracion
+ * separadas por la barrera fase. Nadie debe empezar una fase antes de que
+ * los cuatro hayan terminado la anterior.
+ */
+
+#include "servicios.h"
+
+#define N_PROCS 4
+#define N_FASES 3
+
+/* variable compartida por todos los procesos de este programa */
+int terminados[N_FASES];
+
+int main(){
+	int i, j, id, desc, tot=0;
+
+	id=obtener_id_pr();
+	if ((desc=abrir_barrera("fase"))<0) {
+		printf("etapa (%d): error abriendo fase\n", id);
+		return -1;
+	}
+
+	for (i=0; i<N_FASES; i++) {
+		for (j=0; j<(id+1)*2000000; j++)
+			tot+=j;
+		terminados[i]++;
+		if (esperar_barrera(desc)==1)
+			printf("etapa (%d): completa la fase %d\n", id, i);
+		if (terminados[i]!=N_PROCS)
+			printf("etapa (%d): sale antes de tiempo. NO DEBE SALIR\n", id);
+	}
+
+	printf("etapa (%d): termina\n", id);
+	tot--;
+	return 0;
+}
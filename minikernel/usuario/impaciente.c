@@ -0,0 +1,41 @@
+/*
+ * usuario/impaciente.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que intenta coger el mutex mt, que prueba_trylock
+ * tiene cogido durante un segundo: primero sin esperar, luego con un
+ * plazo que vence antes y por ultimo con uno suficiente.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int desc;
+	unsigned int inicio;
+
+	if ((desc=abrir_mutex("mt"))<0) {
+		printf("impaciente: error abriendo mt\n");
+		return -1;
+	}
+
+	inicio=obtener_ticks();
+	if (trylock(desc)>=0)
+		printf("impaciente: trylock de mt cogido. NO DEBE SALIR\n");
+
+	if (lock_timeout(desc, 300)>=0)
+		printf("impaciente: lock_timeout antes de soltarlo. NO DEBE SALIR\n");
+	printf("impaciente: vence el plazo tras %d ticks (300 ms)\n",
+		obtener_ticks()-inicio);
+
+	if (lock_timeout(desc, 5000)<0)
+		printf("impaciente: vence el plazo largo. NO DEBE SALIR\n");
+	printf("impaciente: coge mt en el tick %u\n", obtener_ticks());
+	unlock(desc);
+
+	printf("impaciente: termina\n");
+	return 0;
+}
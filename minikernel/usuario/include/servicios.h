@@ -34,6 +34,16 @@ int obtener_id_pr();
 //Llamada a la funcion dormir
 int dormir (unsigned int segundos);
 
+//Dormir con resolucion de milisegundos o hasta un tick absoluto, y
+//obtener los ticks transcurridos desde el arranque. Los ticks son los 32
+//bits bajos de un contador de 64 y dan la vuelta: para compararlos hay
+//que restarlos ((int)(a-b)>0 si a es posterior). dormir_hasta toma el tick
+//con esos bits mas cercano al actual (hasta 2^31 ticks en cada sentido)
+#define TICKS_POR_SEG 100
+int dormir_ms (unsigned int ms);
+int dormir_hasta (unsigned int tick);
+unsigned int obtener_ticks ();
+
 //Definicion de mutex recursivo o no
 #define RECURSIVO 1
 #define NO_RECURSIVO 0
@@ -45,5 +55,121 @@ int lock (unsigned int mutex_id);
 int unlock (unsigned int mutex_id);
 int cerrar_mutex (unsigned int mutex_id);
 
+//Lock sin espera (-1 si lo tiene otro) y con plazo en milisegundos
+int trylock (unsigned int mutex_id);
+int lock_timeout (unsigned int mutex_id, unsigned int ms);
+
+//Estadisticas de uso de un mutex, en ticks (misma forma que en el nucleo).
+//estadisticas_mutex rellena las del primer mutex en uso desde la posicion
+//indicada y devuelve su posicion, o -1 si no hay mas
+typedef struct {
+	char nombre[9];
+	unsigned int adquisiciones;
+	unsigned int con_espera;
+	unsigned int espera_total;
+	unsigned int espera_max;
+	unsigned int retencion_total;
+	unsigned int retencion_max;
+	unsigned int cola_max;
+} estad_mutex;
+int estadisticas_mutex (int pos, estad_mutex *est);
+
+//Prioridades: 0 es la maxima y 31 la minima. Devuelve la prioridad previa
+#define PRIO_MAX 0
+#define PRIO_MIN 31
+int fijar_prioridad (int prioridad);
+
+//Tickets de la politica stride: la UCP se reparte en proporcion a ellos.
+//Devuelve los tickets previos
+#define TICKETS_DEFECTO 100
+int fijar_tickets (int tickets);
+
+//Clase de tiempo real (EDF), parametros en ticks. Con presupuesto 0 se
+//vuelve a la politica normal. Devuelve -1 si no se admite la reserva
+int fijar_tiempo_real (unsigned int periodo, unsigned int presupuesto,
+			unsigned int plazo);
+
+//Parametros del nucleo: latencia objetivo y granularidad minima de la
+//rodaja (en ticks) y % maximo de UCP para tiempo real. Devuelve el valor
+//previo; con un valor negativo solo lo consulta
+#define PARAM_LATENCIA 0
+#define PARAM_GRANULARIDAD 1
+#define PARAM_UTILIZACION_RT 2
+#define PARAM_CEDER_PROPIETARIO 3 /* 1: lock cede la UCP al propietario */
+#define PARAM_MAX_DESCRIPTORES 4 /* objetos abiertos por proceso (1 a 1024) */
+#define PARAM_MAX_MUTEX 5 /* mutex en el sistema (1 a 4096) */
+int fijar_parametro (int parametro, int valor);
+
+//Ceder la UCP: al final de la cola de listos o directamente al proceso
+//indicado, que debe estar listo
+int ceder ();
+int ceder_a (int pid);
+
+//Grupos de procesos: el peso reparte la UCP entre grupos (cfs y stride)
+//y el limite acota los ticks por segundo del grupo (0 sin limite).
+//crear_grupo mete al proceso en el grupo nuevo y devuelve su numero;
+//fijar_grupo solo se admite sobre el grupo del propio proceso
+#define GRUPO_PESO_DEFECTO 1024
+int crear_grupo (int peso, int limite);
+int fijar_grupo (int grupo, int peso, int limite);
+
+//Futex: futex_wait se bloquea si *dir vale valor (si no devuelve -1) y
+//futex_wake despierta hasta n procesos bloqueados en dir
+int futex_wait (int *dir, int valor);
+int futex_wake (int *dir, int n);
+
+//Cerrojo de usuario sobre futex (lib/futex.c): sin contencion no hace
+//llamadas al sistema. La palabra empieza a 0 y debe ser compartida
+void futex_lock (int *cerrojo);
+void futex_unlock (int *cerrojo);
+
+//Semaforos contadores con nombre. Usan los mismos descriptores que los
+//mutex y el proceso que termina cierra los que tenga abiertos
+int crear_sem (char *nombre, int valor);
+int abrir_sem (char *nombre);
+int wait_sem (unsigned int semid);
+int post_sem (unsigned int semid);
+int cerrar_sem (unsigned int semid);
+
+//Variables condicion con nombre. cond_wait suelta el mutex indicado, que
+//debe tener cogido el proceso, y lo vuelve a coger antes de retornar
+int crear_cond (char *nombre);
+int abrir_cond (char *nombre);
+int cond_wait (unsigned int condid, unsigned int mutexid);
+int cond_signal (unsigned int condid);
+int cond_broadcast (unsigned int condid);
+int cerrar_cond (unsigned int condid);
+
+//Cerrojos de lectores y escritores con nombre y preferencia para los
+//escritores. Cada descriptor se coge en un solo modo y unlock_rw lo suelta
+int crear_rw (char *nombre);
+int abrir_rw (char *nombre);
+int lock_lectura (unsigned int rwid);
+int lock_escritura (unsigned int rwid);
+int unlock_rw (unsigned int rwid);
+int cerrar_rw (unsigned int rwid);
+
+//Barreras con nombre para n procesos. esperar_barrera devuelve 1 al
+//ultimo en llegar y 0 a los demas
+int crear_barrera (char *nombre, int n);
+int abrir_barrera (char *nombre);
+int esperar_barrera (unsigned int barreraid);
+int cerrar_barrera (unsigned int barreraid);
+
+//Colas de mensajes con nombre. Los mensajes no se copian: el buffer se
+//pide con reservar_mensaje, enviar se lo pasa a la cola y recibir lo deja
+//en *buf y devuelve su longitud; el receptor lo devuelve con
+//liberar_mensaje. Con NO_BLOQUEANTE enviar (cola llena) y recibir (cola
+//vacia) devuelven -1 en vez de esperar
+#define BLOQUEANTE 0
+#define NO_BLOQUEANTE 1
+int crear_cola (char *nombre, int capacidad);
+int abrir_cola (char *nombre);
+int reservar_mensaje (unsigned int longitud, void **buf);
+int liberar_mensaje (void *buf);
+int enviar (unsigned int colaid, void *buf, int modo);
+int recibir (unsigned int colaid, void **buf, int modo);
+int cerrar_cola (unsigned int colaid);
+
 #endif /* SERVICIOS_H */
 
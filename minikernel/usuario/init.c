@@ -59,6 +59,96 @@ ALGO COMENTE ESTA PARTE Y DESCOMENTE LA PRUEBA CORRESPONDIENTE */
 		printf("Error creando prueba_dormir\n");
 
 
+/* PRUEBA DE LAS LLAMADAS DORMIR_MS, DORMIR_HASTA Y OBTENER_TICKS
+	if (crear_proceso("periodico")<0)
+		printf("Error creando periodico\n");
+*/
+
+/* PRUEBA DE LA POLITICA STRIDE (arrancar con PLANIFICADOR=stride)
+	if (crear_proceso("prueba_stride")<0)
+		printf("Error creando prueba_stride\n");
+*/
+
+/* PRUEBA DE LA CLASE DE TIEMPO REAL
+	if (crear_proceso("prueba_edf")<0)
+		printf("Error creando prueba_edf\n");
+*/
+
+/* PRUEBA DE LA RODAJA ADAPTATIVA Y DE LA LLAMADA FIJAR_PARAMETRO
+	if (crear_proceso("prueba_rodaja")<0)
+		printf("Error creando prueba_rodaja\n");
+*/
+
+/* PRUEBA DE LAS LLAMADAS CEDER Y CEDER_A
+	if (crear_proceso("prueba_ceder")<0)
+		printf("Error creando prueba_ceder\n");
+*/
+
+/* PRUEBA DE LOS GRUPOS DE PROCESOS
+	if (crear_proceso("prueba_grupos")<0)
+		printf("Error creando prueba_grupos\n");
+*/
+
+/* PRUEBA DE FUTEX Y DEL CERROJO DE USUARIO
+	if (crear_proceso("prueba_futex")<0)
+		printf("Error creando prueba_futex\n");
+*/
+
+/* PRUEBA DE SEMAFOROS
+	if (crear_proceso("prueba_sem")<0)
+		printf("Error creando prueba_sem\n");
+*/
+
+/* PRUEBA DE VARIABLES CONDICION
+	if (crear_proceso("prueba_cond")<0)
+		printf("Error creando prueba_cond\n");
+*/
+
+/* PRUEBA DE CERROJOS DE LECTORES Y ESCRITORES
+	if (crear_proceso("prueba_rw")<0)
+		printf("Error creando prueba_rw\n");
+*/
+
+/* PRUEBA DE BARRERAS
+	if (crear_proceso("prueba_barrera")<0)
+		printf("Error creando prueba_barrera\n");
+*/
+
+/* PRUEBA DE TRYLOCK Y LOCK_TIMEOUT
+	if (crear_proceso("prueba_trylock")<0)
+		printf("Error creando prueba_trylock\n");
+*/
+
+/* PRUEBA DE HERENCIA DE PRIORIDAD (con rr o mlfq, que expulsan por prioridad)
+	if (crear_proceso("prueba_herencia")<0)
+		printf("Error creando prueba_herencia\n");
+*/
+
+/* PRUEBA DE LAS ESTADISTICAS DE LOS MUTEX
+	if (crear_proceso("prueba_estad")<0)
+		printf("Error creando prueba_estad\n");
+*/
+
+/* PRUEBA DE LA TABLA DE DESCRIPTORES
+	if (crear_proceso("prueba_descriptores")<0)
+		printf("Error creando prueba_descriptores\n");
+*/
+
+/* PRUEBA DE LA TABLA DE MUTEX DINAMICA
+	if (crear_proceso("prueba_mutex3")<0)
+		printf("Error creando prueba_mutex3\n");
+*/
+
+/* PRUEBA DE LAS COLAS DE MENSAJES
+	if (crear_proceso("prueba_colas")<0)
+		printf("Error creando prueba_colas\n");
+*/
+
+/* PRUEBA DEL CIERRE DE OBJETOS AL TERMINAR POR UNA EXCEPCION
+	if (crear_proceso("prueba_excepcion")<0)
+		printf("Error creando prueba_excepcion\n");
+*/
+
 /* PRUEBA DE LA LLAMADA TIEMPOS_PROCESO
 	if (crear_proceso("prueba_tiempos")<0)
 		printf("Error creando prueba_tiempos\n");
@@ -84,6 +174,11 @@ ALGO COMENTE ESTA PARTE Y DESCOMENTE LA PRUEBA CORRESPONDIENTE */
 		printf("Error creando prueba_RR2\n");
 */
 
+/* PRUEBA DE PRIORIDADES
+	if (crear_proceso("prueba_prio")<0)
+		printf("Error creando prueba_prio\n");
+*/
+
 /* PRUEBA DEL TERMINAL
 	if (crear_proceso("prueba_term")<0)
 		printf("Error creando prueba_term\n");
@@ -0,0 +1,47 @@
+/*
+ *  usuario/lib/futex.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ *
+ * Fichero que contiene un cerrojo de usuario construido sobre futex.
+ * La palabra del cerrojo vale 0 si esta libre, 1 si esta cogido sin
+ * procesos esperando y 2 si puede haber procesos esperando. Cogerlo y
+ * soltarlo sin contencion es una sola operacion atomica, sin llamada al
+ * sistema; solo se llama a futex_wait/futex_wake cuando hay contencion.
+ *
+ * La palabra debe estar en memoria compartida por los procesos que usan
+ * el cerrojo, p.ej. una variable global de un programa del que se crean
+ * varios procesos.
+ *
+ */
+
+#include "servicios.h"
+
+void futex_lock(int *cerrojo){
+	int c=0;
+
+	/* caso rapido: libre -> cogido sin esperas */
+	if (__atomic_compare_exchange_n(cerrojo, &c, 1, 0, __ATOMIC_ACQUIRE,
+		__ATOMIC_RELAXED))
+		return;
+
+	/* hay contencion: se marca con 2 y se espera mientras siga cogido */
+	if (c!=2)
+		c=__atomic_exchange_n(cerrojo, 2, __ATOMIC_ACQUIRE);
+	while (c!=0) {
+		futex_wait(cerrojo, 2);
+		c=__atomic_exchange_n(cerrojo, 2, __ATOMIC_ACQUIRE);
+	}
+}
+
+void futex_unlock(int *cerrojo){
+	/* si valia 2 puede haber alguien esperando: se despierta a uno */
+	if (__atomic_fetch_sub(cerrojo, 1, __ATOMIC_RELEASE)!=1) {
+		__atomic_store_n(cerrojo, 0, __ATOMIC_RELEASE);
+		futex_wake(cerrojo, 1);
+	}
+}
@@ -44,23 +44,158 @@ int escribir(char *texto, unsigned int longi){
 	return llamsis(ESCRIBIR, 2, (long)texto, (long)longi);
 }
 int obtener_id_pr(){
-	return llamsis(OBTENERID, 3);
+	return llamsis(OBTENERID, 0);
 }
 int dormir (unsigned int segundos) {
-	return llamsis(DORMIR, 4, (long) segundos);
+	return llamsis(DORMIR, 1, (long) segundos);
 }
 int crear_mutex (char* nombre, int tipo) {
-	return llamsis(CREAR_MUTEX, 5, (long) nombre,(long) tipo);
+	return llamsis(CREAR_MUTEX, 2, (long) nombre,(long) tipo);
 }
 int abrir_mutex (char* nombre) {
-	return llamsis(ABRIR_MUTEX, 6, (long) nombre);
+	return llamsis(ABRIR_MUTEX, 1, (long) nombre);
 }
 int lock (unsigned int mutex_id) {
-	return llamsis(LOCK, 7, (long) mutex_id);
+	return llamsis(LOCK, 1, (long) mutex_id);
 }
 int unlock (unsigned int mutex_id) {
-	return llamsis(UNLOCK, 8, (long) mutex_id);
+	return llamsis(UNLOCK, 1, (long) mutex_id);
 }
 int cerrar_mutex (unsigned int mutex_id) {
-	return llamsis(CERRAR_MUTEX, 9, (long) mutex_id);
+	return llamsis(CERRAR_MUTEX, 1, (long) mutex_id);
+}
+int fijar_prioridad (int prioridad) {
+	return llamsis(FIJAR_PRIORIDAD, 1, (long) prioridad);
+}
+int dormir_ms (unsigned int ms) {
+	return llamsis(DORMIR_MS, 1, (long) ms);
+}
+int dormir_hasta (unsigned int tick) {
+	return llamsis(DORMIR_HASTA, 1, (long) tick);
+}
+unsigned int obtener_ticks () {
+	return (unsigned int)llamsis(OBTENER_TICKS, 0);
+}
+int fijar_tickets (int tickets) {
+	return llamsis(FIJAR_TICKETS, 1, (long) tickets);
+}
+int fijar_tiempo_real (unsigned int periodo, unsigned int presupuesto,
+			unsigned int plazo) {
+	return llamsis(FIJAR_TIEMPO_REAL, 3, (long) periodo,
+			(long) presupuesto, (long) plazo);
+}
+int fijar_parametro (int parametro, int valor) {
+	return llamsis(FIJAR_PARAMETRO, 2, (long) parametro, (long) valor);
+}
+int ceder () {
+	return llamsis(CEDER, 0);
+}
+int ceder_a (int pid) {
+	return llamsis(CEDER_A, 1, (long) pid);
+}
+int crear_grupo (int peso, int limite) {
+	return llamsis(CREAR_GRUPO, 2, (long) peso, (long) limite);
+}
+int fijar_grupo (int grupo, int peso, int limite) {
+	return llamsis(FIJAR_GRUPO, 3, (long) grupo, (long) peso,
+			(long) limite);
+}
+int futex_wait (int *dir, int valor) {
+	return llamsis(FUTEX_WAIT, 2, (long) dir, (long) valor);
+}
+int futex_wake (int *dir, int n) {
+	return llamsis(FUTEX_WAKE, 2, (long) dir, (long) n);
+}
+int crear_sem (char *nombre, int valor) {
+	return llamsis(CREAR_SEM, 2, (long) nombre, (long) valor);
+}
+int abrir_sem (char *nombre) {
+	return llamsis(ABRIR_SEM, 1, (long) nombre);
+}
+int wait_sem (unsigned int semid) {
+	return llamsis(WAIT_SEM, 1, (long) semid);
+}
+int post_sem (unsigned int semid) {
+	return llamsis(POST_SEM, 1, (long) semid);
+}
+int cerrar_sem (unsigned int semid) {
+	return llamsis(CERRAR_SEM, 1, (long) semid);
+}
+int crear_cond (char *nombre) {
+	return llamsis(CREAR_COND, 1, (long) nombre);
+}
+int abrir_cond (char *nombre) {
+	return llamsis(ABRIR_COND, 1, (long) nombre);
+}
+int cond_wait (unsigned int condid, unsigned int mutexid) {
+	return llamsis(COND_WAIT, 2, (long) condid, (long) mutexid);
+}
+int cond_signal (unsigned int condid) {
+	return llamsis(COND_SIGNAL, 1, (long) condid);
+}
+int cond_broadcast (unsigned int condid) {
+	return llamsis(COND_BROADCAST, 1, (long) condid);
+}
+int cerrar_cond (unsigned int condid) {
+	return llamsis(CERRAR_COND, 1, (long) condid);
+}
+int crear_rw (char *nombre) {
+	return llamsis(CREAR_RW, 1, (long) nombre);
+}
+int abrir_rw (char *nombre) {
+	return llamsis(ABRIR_RW, 1, (long) nombre);
+}
+int lock_lectura (unsigned int rwid) {
+	return llamsis(LOCK_LECTURA, 1, (long) rwid);
+}
+int lock_escritura (unsigned int rwid) {
+	return llamsis(LOCK_ESCRITURA, 1, (long) rwid);
+}
+int unlock_rw (unsigned int rwid) {
+	return llamsis(UNLOCK_RW, 1, (long) rwid);
+}
+int cerrar_rw (unsigned int rwid) {
+	return llamsis(CERRAR_RW, 1, (long) rwid);
+}
+int crear_barrera (char *nombre, int n) {
+	return llamsis(CREAR_BARRERA, 2, (long) nombre, (long) n);
+}
+int abrir_barrera (char *nombre) {
+	return llamsis(ABRIR_BARRERA, 1, (long) nombre);
+}
+int esperar_barrera (unsigned int barreraid) {
+	return llamsis(ESPERAR_BARRERA, 1, (long) barreraid);
+}
+int cerrar_barrera (unsigned int barreraid) {
+	return llamsis(CERRAR_BARRERA, 1, (long) barreraid);
+}
+int trylock (unsigned int mutexid) {
+	return llamsis(TRYLOCK, 1, (long) mutexid);
+}
+int lock_timeout (unsigned int mutexid, unsigned int ms) {
+	return llamsis(LOCK_TIMEOUT, 2, (long) mutexid, (long) ms);
+}
+int estadisticas_mutex (int pos, estad_mutex *est) {
+	return llamsis(ESTADISTICAS_MUTEX, 2, (long) pos, (long) est);
+}
+int crear_cola (char *nombre, int capacidad) {
+	return llamsis(CREAR_COLA, 2, (long) nombre, (long) capacidad);
+}
+int abrir_cola (char *nombre) {
+	return llamsis(ABRIR_COLA, 1, (long) nombre);
+}
+int enviar (unsigned int colaid, void *buf, int modo) {
+	return llamsis(ENVIAR, 3, (long) colaid, (long) buf, (long) modo);
+}
+int recibir (unsigned int colaid, void **buf, int modo) {
+	return llamsis(RECIBIR, 3, (long) colaid, (long) buf, (long) modo);
+}
+int cerrar_cola (unsigned int colaid) {
+	return llamsis(CERRAR_COLA, 1, (long) colaid);
+}
+int reservar_mensaje (unsigned int longitud, void **buf) {
+	return llamsis(RESERVAR_MENSAJE, 2, (long) longitud, (long) buf);
+}
+int liberar_mensaje (void *buf) {
+	return llamsis(LIBERAR_MENSAJE, 1, (long) buf);
 }
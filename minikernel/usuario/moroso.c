@@ -0,0 +1,35 @@
+/*
+ * usuario/moroso.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que coge el mutex mx y termina por una excepcion
+ * aritmetica sin soltarlo ni liberar un mensaje que ha reservado.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int desc, i, tot=0;
+	void *buf;
+
+	printf("moroso comienza\n");
+
+	if (((desc=abrir_mutex("mx"))<0) || (lock(desc)<0)) {
+		printf("moroso: error cogiendo mx\n");
+		return -1;
+	}
+
+	if (reservar_mensaje(1024, &buf)<0)
+		printf("moroso: error reservando mensaje\n");
+	dormir_ms(500);
+	printf("moroso: provoca una excepcion con mx cogido\n");
+	i=desc/tot;
+
+	/* No deberia llegar ya que ha generado una excepcion */
+	printf("moroso: termina %d\n", i);
+	return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * usuario/periodico.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las llamadas dormir_ms,
+ * dormir_hasta y obtener_ticks: ejecuta un bucle con un periodo de 250 ms
+ * sin acumular deriva aunque cada iteracion gaste UCP.
+ */
+
+#include "servicios.h"
+
+#define PERIODO (TICKS_POR_SEG/4)	/* 250 ms */
+#define TOT_ITER 8
+
+int main(){
+	int i, j, tot=0;
+	unsigned int inicio, siguiente;
+
+	printf("periodico: comienza\n");
+
+	inicio=obtener_ticks();
+	dormir_ms(100);
+	printf("periodico: dormir_ms(100) ha durado %d ticks\n",
+		obtener_ticks()-inicio);
+
+	siguiente=obtener_ticks();
+	for (i=0; i<TOT_ITER; i++) {
+		for (j=0; j<1000000; j++)
+			tot+=j;
+		siguiente+=PERIODO;
+		dormir_hasta(siguiente);
+		printf("periodico: iteracion %d en tick %u (previsto %u)\n",
+			i, obtener_ticks(), siguiente);
+	}
+
+	printf("periodico: termina\n");
+	tot--;
+	return 0;
+}
@@ -0,0 +1,34 @@
+/*
+ * usuario/prioritario.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que fija una prioridad que depende de su pid y
+ * duerme. Como todos despiertan en el mismo tick, deben terminar en
+ * orden de prioridad: primero el de mayor pid.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 5	/* ponga las que considere oportuno */
+
+int main(){
+	int i, id, prio;
+
+	id=obtener_id_pr();
+	prio=PRIO_MIN-id;
+	if (fijar_prioridad(prio)<0)
+		printf("prioritario (%d): error fijando prioridad. NO DEBE SALIR\n", id);
+
+	printf("prioritario (%d): prioridad %d, duerme 1 segundo\n", id, prio);
+	dormir(1);
+
+	for (i=0; i<TOT_ITER; i++)
+		printf("prioritario (%d): i %d\n", id, i);
+
+	printf("prioritario (%d): termina\n", id);
+	return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * usuario/prueba_barrera.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las barreras: crea la
+ * barrera fase para cuatro procesos y arranca cuatro etapa.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, desc;
+
+	printf("prueba_barrera: comienza\n");
+
+	if ((desc=crear_barrera("fase", 4))<0)
+		printf("error creando fase. NO DEBE SALIR\n");
+	if (crear_barrera("otra", 0)>=0)
+		printf("barrera para 0 procesos. NO DEBE SALIR\n");
+
+	for (i=1; i<=4; i++)
+		if (crear_proceso("etapa")<0)
+			printf("Error creando etapa\n");
+
+	/* mantiene la barrera hasta que los etapa la abren */
+	dormir(1);
+	cerrar_barrera(desc);
+
+	printf("prueba_barrera: termina\n");
+	return 0; 
+}
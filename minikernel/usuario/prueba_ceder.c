@@ -0,0 +1,31 @@
+/*
+ * usuario/prueba_ceder.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las llamadas ceder y
+ * ceder_a: arranca dos cedente, que se ceden la UCP el uno al otro.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_ceder: comienza\n");
+
+	if (ceder_a(obtener_id_pr())==0)
+		printf("prueba_ceder: cedida a si mismo. NO DEBE SALIR\n");
+	if (ceder_a(-1)==0)
+		printf("prueba_ceder: cedida a pid invalido. NO DEBE SALIR\n");
+
+	for (i=1; i<=2; i++)
+		if (crear_proceso("cedente")<0)
+			printf("Error creando cedente\n");
+
+	printf("prueba_ceder: termina\n");
+	return 0; 
+}
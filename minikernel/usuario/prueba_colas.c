@@ -0,0 +1,83 @@
+/*
+ * usuario/prueba_colas.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las colas de mensajes:
+ * prueba los modos no bloqueantes con la cola c1 y despues recibe los
+ * mensajes de emisor, comprobando que llegan en orden y que son los
+ * mismos buffers que relleno emisor (no se copian).
+ */
+
+#include "servicios.h"
+
+#define CAPACIDAD 4
+#define N_MENSAJES 10
+#define TAM_MENSAJE 65536
+
+/* cabecera que pone emisor en cada mensaje */
+typedef struct {
+	void *buffer;	/* direccion en la que lo relleno */
+	int n;
+} cabecera;
+
+int main(){
+	int i, desc, longitud;
+	void *buf, *msj[CAPACIDAD];
+	cabecera *cab;
+
+	printf("prueba_colas: comienza\n");
+
+	if ((desc=crear_cola("c1", CAPACIDAD))<0)
+		printf("error creando c1. NO DEBE SALIR\n");
+	if (crear_cola("otra", 0)>=0)
+		printf("cola de capacidad 0. NO DEBE SALIR\n");
+
+	if (recibir(desc, &buf, NO_BLOQUEANTE)<0)
+		printf("recibir sin espera de c1 vacia. DEBE SALIR\n");
+	for (i=0; i<CAPACIDAD; i++) {
+		if (reservar_mensaje(sizeof(int), &msj[i])<0)
+			printf("error reservando mensaje. NO DEBE SALIR\n");
+		*(int *)msj[i]=i;
+		if (enviar(desc, msj[i], NO_BLOQUEANTE)<0)
+			printf("error enviando %d. NO DEBE SALIR\n", i);
+	}
+	if (enviar(desc, msj[0], BLOQUEANTE)>=0)
+		printf("enviado un mensaje que ya no es suyo. NO DEBE SALIR\n");
+	reservar_mensaje(sizeof(int), &buf);
+	if (enviar(desc, buf, NO_BLOQUEANTE)<0)
+		printf("enviar sin espera a c1 llena. DEBE SALIR\n");
+	liberar_mensaje(buf);
+	if (liberar_mensaje(buf)<0)
+		printf("liberar un mensaje ya liberado. DEBE SALIR\n");
+	for (i=0; i<CAPACIDAD; i++) {
+		if ((recibir(desc, &buf, NO_BLOQUEANTE)!=sizeof(int)) ||
+			(buf!=msj[i]) || (*(int *)buf!=i))
+			printf("error recibiendo %d. NO DEBE SALIR\n", i);
+		liberar_mensaje(buf);
+	}
+
+	/* emisor llena la cola y se bloquea hasta que empieza a recibir */
+	if (crear_proceso("emisor")<0)
+		printf("Error creando emisor\n");
+	dormir(1);
+
+	for (i=0; i<N_MENSAJES; i++) {
+		longitud=recibir(desc, &buf, BLOQUEANTE);
+		cab=buf;
+		if ((longitud!=TAM_MENSAJE) || (cab->n!=i))
+			printf("error recibiendo %d. NO DEBE SALIR\n", i);
+		else if (cab->buffer!=buf)
+			printf("el mensaje %d se ha copiado. NO DEBE SALIR\n", i);
+		else
+			printf("prueba_colas: recibe %d\n", i);
+		liberar_mensaje(buf);
+	}
+	cerrar_cola(desc);
+
+	printf("prueba_colas: termina\n");
+	return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * usuario/prueba_cond.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las variables condicion:
+ * crea el mutex y la variable y arranca cuatro esperador, que deben
+ * escribir su turno en orden inverso al de llegada.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, cond, mut;
+
+	printf("prueba_cond: comienza\n");
+
+	if ((mut=crear_mutex("mturno", NO_RECURSIVO))<0)
+		printf("error creando mturno. NO DEBE SALIR\n");
+	if ((cond=crear_cond("cturno"))<0)
+		printf("error creando cturno. NO DEBE SALIR\n");
+	if (cond_wait(cond, mut)>=0)
+		printf("cond_wait sin tener el mutex. NO DEBE SALIR\n");
+	if (cond_signal(cond)<0)
+		printf("error en cond_signal sin esperas. NO DEBE SALIR\n");
+
+	for (i=1; i<=4; i++)
+		if (crear_proceso("esperador")<0)
+			printf("Error creando esperador\n");
+
+	/* mantiene los objetos hasta que los esperador los abren */
+	dormir(1);
+
+	printf("prueba_cond: termina\n");
+	return 0; 
+}
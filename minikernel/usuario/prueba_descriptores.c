@@ -0,0 +1,52 @@
+/*
+ * usuario/prueba_descriptores.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la tabla de descriptores: con el limite
+ * por defecto no puede abrir mas de NUM_MUT_PROC objetos y, tras subirlo,
+ * la tabla crece para abrir muchas veces el mismo semaforo. Deja abierta
+ * la mitad para que se cierren al terminar.
+ */
+
+#include "servicios.h"
+
+#define DESCRIPTORES 40
+
+int main(){
+	int i, desc[DESCRIPTORES], previo;
+
+	printf("prueba_descriptores: comienza\n");
+
+	if ((desc[0]=crear_sem("sd", 0))<0)
+		printf("error creando sd. NO DEBE SALIR\n");
+	for (i=1; i<4; i++)
+		if ((desc[i]=abrir_sem("sd"))<0)
+			printf("error abriendo sd %d. NO DEBE SALIR\n", i);
+	if (abrir_sem("sd")<0)
+		printf("error abriendo sd con el limite por defecto. DEBE SALIR\n");
+
+	previo=fijar_parametro(PARAM_MAX_DESCRIPTORES, DESCRIPTORES);
+	for (i=4; i<DESCRIPTORES; i++)
+		if ((desc[i]=abrir_sem("sd"))<0)
+			printf("error abriendo sd %d. NO DEBE SALIR\n", i);
+	if (abrir_sem("sd")<0)
+		printf("error abriendo sd por encima del limite. DEBE SALIR\n");
+
+	/* los descriptores cerrados se reutilizan */
+	for (i=0; i<DESCRIPTORES; i+=2)
+		cerrar_sem(desc[i]);
+	for (i=0; i<DESCRIPTORES; i+=2)
+		if (abrir_cond("sd")>=0 || abrir_sem("sd")<0)
+			printf("error reabriendo sd %d. NO DEBE SALIR\n", i);
+	if (post_sem(desc[1])<0 || wait_sem(desc[DESCRIPTORES-1])<0)
+		printf("error usando sd. NO DEBE SALIR\n");
+	fijar_parametro(PARAM_MAX_DESCRIPTORES, previo);
+
+	printf("prueba_descriptores: termina con %d descriptores abiertos\n",
+		DESCRIPTORES);
+	return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * usuario/prueba_edf.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la clase de tiempo real:
+ * arranca dos procesos que gastan UCP y dos controladores periodicos que
+ * no deben incumplir ningun plazo. Tambien comprueba que se rechaza una
+ * reserva que supera la utilizacion maxima.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_edf: comienza\n");
+
+	if (fijar_tiempo_real(10, 10, 10)==0)
+		printf("prueba_edf: admitida reserva del 100%%. NO DEBE SALIR\n");
+	if (fijar_tiempo_real(5000000, 5000000, 5000000)==0)
+		printf("prueba_edf: admitida reserva larga del 100%%. NO DEBE SALIR\n");
+	if (fijar_tiempo_real(10, 2, 5)<0)
+		printf("prueba_edf: rechazada reserva del 40%%. NO DEBE SALIR\n");
+	fijar_tiempo_real(0, 0, 0);
+
+	for (i=1; i<=2; i++)
+		if (crear_proceso("repartidor")<0)
+			printf("Error creando repartidor\n");
+	for (i=1; i<=2; i++)
+		if (crear_proceso("controlador")<0)
+			printf("Error creando controlador\n");
+
+	printf("prueba_edf: termina\n");
+	return 0; 
+}
@@ -0,0 +1,40 @@
+/*
+ * usuario/prueba_estad.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las estadisticas de los
+ * mutex: arranca tres contendiente que se disputan el mutex me y, cuando
+ * terminan, vuelca las estadisticas con volcar_mutex. Deben salir 15
+ * adquisiciones con retencion de 10 ticks y una cola de hasta 2 procesos.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, desc;
+
+	printf("prueba_estad: comienza\n");
+
+	/* crea me para que siga existiendo al terminar los contendiente */
+	if ((desc=crear_mutex("me", NO_RECURSIVO))<0)
+		printf("error creando me. NO DEBE SALIR\n");
+
+	if (estadisticas_mutex(0, (estad_mutex *)0)<0)
+		printf("estadisticas sin buffer. DEBE SALIR\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("contendiente")<0)
+			printf("Error creando contendiente\n");
+
+	dormir(2);
+	if (crear_proceso("volcar_mutex")<0)
+		printf("Error creando volcar_mutex\n");
+	dormir(1);
+
+	printf("prueba_estad: termina\n");
+	return 0; 
+}
@@ -0,0 +1,35 @@
+/*
+ * usuario/prueba_excepcion.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que comprueba que un proceso que termina por una
+ * excepcion cierra sus objetos: moroso coge el mutex mx y provoca una
+ * excepcion aritmetica mientras este proceso espera por el.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int desc;
+
+	printf("prueba_excepcion: comienza\n");
+
+	if ((desc=crear_mutex("mx", NO_RECURSIVO))<0)
+		printf("error creando mx. NO DEBE SALIR\n");
+	if (crear_proceso("moroso")<0)
+		printf("Error creando moroso\n");
+
+	/* deja que moroso coja mx y espera por el */
+	dormir_ms(100);
+	if (lock_timeout(desc, 3000)<0)
+		printf("mx sigue cogido por moroso. NO DEBE SALIR\n");
+	else
+		printf("prueba_excepcion: coge mx al morir moroso\n");
+
+	printf("prueba_excepcion: termina\n");
+	return 0;
+}
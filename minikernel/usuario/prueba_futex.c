@@ -0,0 +1,35 @@
+/*
+ * usuario/prueba_futex.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de futex_wait, futex_wake y
+ * del cerrojo de usuario: arranca tres contador que incrementan un
+ * contador compartido protegido por el cerrojo. Reduce la rodaja al
+ * minimo para que haya mas expulsiones con el cerrojo cogido.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, palabra=0;
+
+	printf("prueba_futex: comienza\n");
+
+	if (futex_wait(&palabra, 1)==0)
+		printf("prueba_futex: bloqueado con valor distinto. NO DEBE SALIR\n");
+	if (futex_wake(&palabra, 1)!=0)
+		printf("prueba_futex: despertado sin esperas. NO DEBE SALIR\n");
+
+	fijar_parametro(PARAM_LATENCIA, 1);
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("contador")<0)
+			printf("Error creando contador\n");
+
+	printf("prueba_futex: termina\n");
+	return 0; 
+}
@@ -0,0 +1,41 @@
+/*
+ * usuario/prueba_grupos.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de los grupos de procesos:
+ * arranca un repartidor en el grupo inicial y tres en un grupo limitado
+ * a un 20% de la UCP. El primero debe hacer muchas mas iteraciones que
+ * los otros tres juntos.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, grupo;
+
+	printf("prueba_grupos: comienza\n");
+
+	if (crear_proceso("repartidor")<0)
+		printf("Error creando repartidor\n");
+
+	if (crear_grupo(0, 0)>=0)
+		printf("prueba_grupos: admitido peso 0. NO DEBE SALIR\n");
+	grupo=crear_grupo(GRUPO_PESO_DEFECTO, TICKS_POR_SEG/5);
+	if (grupo<0)
+		printf("prueba_grupos: error creando grupo. NO DEBE SALIR\n");
+	if (fijar_grupo(0, 1, 1)>=0)
+		printf("prueba_grupos: cambiado otro grupo. NO DEBE SALIR\n");
+	if (fijar_grupo(grupo, GRUPO_PESO_DEFECTO, TICKS_POR_SEG/5)<0)
+		printf("prueba_grupos: error cambiando su grupo. NO DEBE SALIR\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("repartidor")<0)
+			printf("Error creando repartidor\n");
+
+	printf("prueba_grupos: termina\n");
+	return 0; 
+}
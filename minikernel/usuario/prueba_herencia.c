@@ -0,0 +1,33 @@
+/*
+ * usuario/prueba_herencia.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la herencia de prioridad
+ * transitiva. Arranca cuatro escalon que hacen de proceso bajo (tiene
+ * m1), medio (tiene m2 y espera por m1), alto (espera por m2) y ocupado
+ * (calcula con prioridad intermedia). Con herencia bajo y medio reciben
+ * la prioridad de alto, asi que bajo suelta m1 y alto termina antes que
+ * ocupado; si no, ocupado lo indica con un NO DEBE SALIR. Requiere una
+ * politica que expulse por prioridad (rr o mlfq).
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_herencia: comienza\n");
+	fijar_prioridad(PRIO_MAX);
+
+	/* los crea todos seguidos para que se preparen a la vez */
+	for (i=1; i<=4; i++)
+		if (crear_proceso("escalon")<0)
+			printf("Error creando escalon\n");
+
+	printf("prueba_herencia: termina\n");
+	return 0; 
+}
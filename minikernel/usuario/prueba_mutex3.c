@@ -0,0 +1,76 @@
+/*
+ * usuario/prueba_mutex3.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la tabla de mutex dinamica: sube el
+ * limite de mutex y crea muchos, comprueba que creador1 se bloquea al
+ * llegar al limite y se desbloquea al subirlo, y recicla la mitad.
+ */
+
+#include "servicios.h"
+
+#define MUCHOS 200
+
+static void nombre_mutex(char *nombre, char letra, int n){
+	nombre[0]=letra;
+	nombre[1]='0'+n/100;
+	nombre[2]='0'+n/10%10;
+	nombre[3]='0'+n%10;
+	nombre[4]='\0';
+}
+
+static int contar_mutex(){
+	int pos, n=0;
+	estad_mutex est;
+
+	for (pos=0; (pos=estadisticas_mutex(pos, &est))>=0; pos++)
+		n++;
+	return n;
+}
+
+int main(){
+	int i, desc[MUCHOS], previo_desc, previo_mut;
+	char nombre[9];
+
+	printf("prueba_mutex3: comienza\n");
+
+	previo_desc=fijar_parametro(PARAM_MAX_DESCRIPTORES, 2*MUCHOS);
+	previo_mut=fijar_parametro(PARAM_MAX_MUTEX, MUCHOS);
+
+	for (i=0; i<MUCHOS; i++) {
+		nombre_mutex(nombre, 'k', i);
+		if ((desc[i]=crear_mutex(nombre, NO_RECURSIVO))<0)
+			printf("error creando %s. NO DEBE SALIR\n", nombre);
+		else if ((lock(desc[i])<0) || (unlock(desc[i])<0))
+			printf("error usando %s. NO DEBE SALIR\n", nombre);
+	}
+	printf("prueba_mutex3: %d mutex en uso (DEBE SER %d)\n",
+		contar_mutex(), MUCHOS);
+
+	/* creador1 se bloquea al crear m1 hasta que sube el limite */
+	if (crear_proceso("creador1")<0)
+		printf("Error creando creador1\n");
+	dormir(1);
+	printf("prueba_mutex3: sube el limite de mutex\n");
+	fijar_parametro(PARAM_MAX_MUTEX, MUCHOS+4);
+	dormir(1);
+
+	/* los mutex cerrados se reutilizan */
+	for (i=0; i<MUCHOS; i+=2)
+		cerrar_mutex(desc[i]);
+	for (i=0; i<MUCHOS; i+=2) {
+		nombre_mutex(nombre, 'j', i);
+		if (crear_mutex(nombre, RECURSIVO)<0)
+			printf("error creando %s. NO DEBE SALIR\n", nombre);
+	}
+
+	fijar_parametro(PARAM_MAX_MUTEX, previo_mut);
+	fijar_parametro(PARAM_MAX_DESCRIPTORES, previo_desc);
+
+	printf("prueba_mutex3: termina\n");
+	return 0;
+}
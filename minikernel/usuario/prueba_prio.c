@@ -0,0 +1,25 @@
+/*
+ * usuario/prueba_prio.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la llamada fijar_prioridad
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_prio: comienza\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("prioritario")<0)
+			printf("Error creando prioritario\n");
+
+	printf("prueba_prio: termina\n");
+	return 0; 
+}
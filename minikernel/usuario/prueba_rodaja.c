@@ -0,0 +1,39 @@
+/*
+ * usuario/prueba_rodaja.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la llamada fijar_parametro
+ * y de la rodaja adaptativa: consulta y cambia la latencia objetivo y la
+ * granularidad minima y arranca varios procesos que gastan UCP.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_rodaja: comienza\n");
+
+	printf("prueba_rodaja: latencia %d granularidad %d\n",
+		fijar_parametro(PARAM_LATENCIA, -1),
+		fijar_parametro(PARAM_GRANULARIDAD, -1));
+
+	if (fijar_parametro(PARAM_LATENCIA, 0)>=0)
+		printf("prueba_rodaja: admitida latencia 0. NO DEBE SALIR\n");
+	if (fijar_parametro(99, 1)>=0)
+		printf("prueba_rodaja: admitido parametro inexistente. NO DEBE SALIR\n");
+
+	fijar_parametro(PARAM_LATENCIA, 60);
+	fijar_parametro(PARAM_GRANULARIDAD, 5);
+
+	for (i=1; i<=4; i++)
+		if (crear_proceso("mudo")<0)
+			printf("Error creando mudo\n");
+
+	printf("prueba_rodaja: termina\n");
+	return 0; 
+}
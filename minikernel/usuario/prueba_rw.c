@@ -0,0 +1,38 @@
+/*
+ * usuario/prueba_rw.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de los cerrojos de lectores
+ * y escritores: crea el cerrojo tabla y arranca cinco accesor, que leen o
+ * escriben segun su identificador.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, desc;
+
+	printf("prueba_rw: comienza\n");
+
+	if ((desc=crear_rw("tabla"))<0)
+		printf("error creando tabla. NO DEBE SALIR\n");
+	if (unlock_rw(desc)>=0)
+		printf("unlock_rw sin tenerlo. NO DEBE SALIR\n");
+	if ((lock_lectura(desc)<0) || (lock_escritura(desc)>=0))
+		printf("error cogiendo para leer. NO DEBE SALIR\n");
+	unlock_rw(desc);
+
+	for (i=1; i<=5; i++)
+		if (crear_proceso("accesor")<0)
+			printf("Error creando accesor\n");
+
+	/* mantiene el cerrojo hasta que los accesor lo abren */
+	dormir(1);
+
+	printf("prueba_rw: termina\n");
+	return 0; 
+}
@@ -0,0 +1,42 @@
+/*
+ * usuario/prueba_sem.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de los semaforos: crea un
+ * semaforo con dos unidades y arranca cuatro trabajador que lo usan para
+ * limitar a dos los procesos dentro de la seccion.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i, desc;
+
+	printf("prueba_sem: comienza\n");
+
+	if ((desc=crear_sem("plazas", 2))<0)
+		printf("error creando plazas. NO DEBE SALIR\n");
+	if (crear_sem("plazas", 1)>=0)
+		printf("creado plazas dos veces. NO DEBE SALIR\n");
+	if (crear_mutex("m1", NO_RECURSIVO)<0)
+		printf("error creando m1. NO DEBE SALIR\n");
+	if (abrir_sem("m1")>=0)
+		printf("abierto mutex como semaforo. NO DEBE SALIR\n");
+	if (lock(desc)>=0)
+		printf("lock sobre un semaforo. NO DEBE SALIR\n");
+
+	for (i=1; i<=4; i++)
+		if (crear_proceso("trabajador")<0)
+			printf("Error creando trabajador\n");
+
+	/* mantiene el semaforo abierto hasta que los trabajadores lo abren */
+	dormir(1);
+	cerrar_sem(desc);
+
+	printf("prueba_sem: termina\n");
+	return 0; 
+}
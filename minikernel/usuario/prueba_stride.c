@@ -0,0 +1,26 @@
+/*
+ * usuario/prueba_stride.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la politica stride y de
+ * la llamada fijar_tickets. Debe arrancarse con PLANIFICADOR=stride.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_stride: comienza\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("repartidor")<0)
+			printf("Error creando repartidor\n");
+
+	printf("prueba_stride: termina\n");
+	return 0; 
+}
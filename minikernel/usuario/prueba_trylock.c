@@ -0,0 +1,40 @@
+/*
+ * usuario/prueba_trylock.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de trylock y lock_timeout:
+ * tiene cogido el mutex mt durante un segundo mientras impaciente
+ * intenta cogerlo con y sin plazo.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int desc;
+
+	printf("prueba_trylock: comienza\n");
+
+	if ((desc=crear_mutex("mt", NO_RECURSIVO))<0)
+		printf("error creando mt. NO DEBE SALIR\n");
+	if (trylock(desc)<0)
+		printf("error en trylock con mt libre. NO DEBE SALIR\n");
+	if (trylock(desc)>=0)
+		printf("trylock de un mutex propio no recursivo. NO DEBE SALIR\n");
+
+	if (crear_proceso("impaciente")<0)
+		printf("Error creando impaciente\n");
+
+	dormir(1);
+	printf("prueba_trylock: suelta mt en el tick %u\n", obtener_ticks());
+	unlock(desc);
+
+	/* mantiene el mutex hasta que impaciente termina */
+	dormir(1);
+
+	printf("prueba_trylock: termina\n");
+	return 0; 
+}
@@ -0,0 +1,39 @@
+/*
+ * usuario/repartidor.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que fija unos tickets que dependen de su pid y
+ * consume UCP durante un intervalo fijo contando iteraciones. Con la
+ * politica stride las cuentas deben guardar la misma proporcion que los
+ * tickets.
+ */
+
+#include "servicios.h"
+
+#define DURACION (2*TICKS_POR_SEG)	/* ticks que consume UCP */
+
+int main(){
+	int id, tickets;
+	unsigned int fin;
+	unsigned long cuenta=0;
+
+	id=obtener_id_pr();
+	tickets=TICKETS_DEFECTO*(id+1);
+	if (fijar_tickets(tickets)<0)
+		printf("repartidor (%d): error fijando tickets. NO DEBE SALIR\n", id);
+
+	/* todos empiezan a la vez para que compitan durante todo el intervalo */
+	dormir_hasta(TICKS_POR_SEG*((obtener_ticks()/TICKS_POR_SEG)+2));
+
+	fin=obtener_ticks()+DURACION;
+	while ((int)(obtener_ticks()-fin)<0)
+		cuenta++;
+
+	printf("repartidor (%d): %d tickets, %lu iteraciones\n", id, tickets,
+		cuenta);
+	return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * usuario/trabajador.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que entra tres veces en la seccion limitada por
+ * el semaforo plazas. Nunca debe haber mas de dos dentro.
+ */
+
+#include "servicios.h"
+
+/* variable compartida por todos los procesos de este programa */
+int dentro=0;
+
+int main(){
+	int i, desc, id;
+
+	id=obtener_id_pr();
+	if ((desc=abrir_sem("plazas"))<0) {
+		printf("trabajador (%d): error abriendo plazas\n", id);
+		return -1;
+	}
+
+	for (i=0; i<3; i++) {
+		wait_sem(desc);
+		printf("trabajador (%d): entra con %d dentro\n", id, dentro++);
+		if (dentro>2)
+			printf("trabajador (%d): demasiados dentro. NO DEBE SALIR\n", id);
+		dormir_ms(200);
+		dentro--;
+		post_sem(desc);
+	}
+
+	printf("trabajador (%d): termina\n", id);
+	/* termina sin cerrar el descriptor: lo cierra el nucleo */
+	return 0;
+}
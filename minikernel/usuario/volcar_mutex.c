@@ -0,0 +1,29 @@
+/*
+ * usuario/volcar_mutex.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que escribe las estadisticas de todos los mutex en
+ * uso: veces que se han cogido (y cuantas con espera), tiempo medio y
+ * maximo de espera y de retencion en ticks, y la cola maxima.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int pos;
+	estad_mutex est;
+
+	printf("mutex     cogido espera  esp.med esp.max  ret.med ret.max cola\n");
+	for (pos=0; (pos=estadisticas_mutex(pos, &est))>=0; pos++)
+		printf("%-9s %6d %6d  %7d %7d  %7d %7d %4d\n", est.nombre,
+			est.adquisiciones, est.con_espera,
+			est.con_espera ? est.espera_total/est.con_espera : 0,
+			est.espera_max,
+			est.adquisiciones ? est.retencion_total/est.adquisiciones : 0,
+			est.retencion_max, est.cola_max);
+	return 0;
+}